@@ -0,0 +1,325 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Headless bridge benchmark.
+
+Run inside Blender in background mode:
+
+    blender --background --factory-startup --python bench/bench_bridge.py -- \\
+        --addon-dir . --lib-dir build-pro/cython/staging/blender_bridge \\
+        --groups 64 --objects 8 --verts 2000 --output bench_results.json
+
+Builds a synthetic scene of N groups x M objects x ~V verts (parent chains of
+--depth levels, with modifiers on every --modifier-every'th object) and times
+standardize_groups (cold and warm), standardize_object_origins, organize and a
+storm of depsgraph updates. Results, per-stage totals and peak RSS are written
+as JSON.
+"""
+
+import argparse
+import importlib.util
+import json
+import math
+import os
+import platform
+import random
+import statistics
+import sys
+import time
+
+import bpy
+import bmesh
+
+BENCH_COLLECTION_NAME = "Pivot Bench"
+
+
+def _parse_args():
+    argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    parser = argparse.ArgumentParser(prog="bench_bridge.py", description="Pivot bridge benchmark")
+    parser.add_argument("--addon-dir", default=os.path.join(os.path.dirname(__file__), ".."),
+                        help="Directory containing the pivot/ addon package")
+    parser.add_argument("--lib-dir", default=None,
+                        help="Staged Cython modules directory, imported as pivot_lib (defaults to the installed pivot_lib)")
+    parser.add_argument("--groups", type=int, default=32)
+    parser.add_argument("--objects", type=int, default=4, help="Objects per group")
+    parser.add_argument("--verts", type=int, default=1000, help="Approximate vertices per object")
+    parser.add_argument("--depth", type=int, default=2, help="Parenting depth inside each group")
+    parser.add_argument("--modifier-every", type=int, default=4,
+                        help="Add modifiers to every Nth object (0 disables)")
+    parser.add_argument("--repeat", type=int, default=3)
+    parser.add_argument("--updates", type=int, default=200, help="Depsgraph updates in the storm")
+    parser.add_argument("--seed", type=int, default=1234)
+    parser.add_argument("--chunk-verts", type=int, default=None,
+                        help="Vertex budget per upload chunk (0 disables chunking)")
+    parser.add_argument("--no-direct-copy", action="store_true",
+                        help="Read mesh data with foreach_get instead of the attribute memcpy path")
+    parser.add_argument("--fill-threads", type=int, default=None,
+                        help="Threads for the direct copy stage (0 = all cores, 1 = serial)")
+    parser.add_argument("--output", default=None, help="JSON output path (stdout when omitted)")
+    return parser.parse_args(argv)
+
+
+def _load_modules(args):
+    """Import pivot_lib and the addon, then register it the way Blender would."""
+    if args.lib_dir:
+        lib_dir = os.path.abspath(args.lib_dir)
+        spec = importlib.util.spec_from_file_location(
+            "pivot_lib", os.path.join(lib_dir, "__init__.py"), submodule_search_locations=[lib_dir])
+        module = importlib.util.module_from_spec(spec)
+        sys.modules["pivot_lib"] = module
+        spec.loader.exec_module(module)
+
+    addon_dir = os.path.abspath(args.addon_dir)
+    if addon_dir not in sys.path:
+        sys.path.insert(0, addon_dir)
+
+    import pivot
+    pivot.register()
+    return pivot
+
+
+# ---------------------------------------------------------------------------
+# Scene generation
+# ---------------------------------------------------------------------------
+
+def _new_grid_mesh(name, verts, rng):
+    """Create a noisy grid mesh with roughly `verts` vertices."""
+    side = max(2, int(math.sqrt(verts)))
+    mesh = bpy.data.meshes.new(name)
+    bm = bmesh.new()
+    bmesh.ops.create_grid(bm, x_segments=side - 1, y_segments=side - 1, size=1.0)
+    for v in bm.verts:
+        v.co.z = rng.uniform(-0.1, 0.1)
+    bm.to_mesh(mesh)
+    bm.free()
+    return mesh
+
+
+def _build_scene(args, rng):
+    """Fill a fresh file with the synthetic groups and return all created objects."""
+    scene = bpy.context.scene
+    bench_coll = bpy.data.collections.new(BENCH_COLLECTION_NAME)
+    scene.collection.children.link(bench_coll)
+    scene.pivot.objects_collection = bench_coll
+
+    objects = []
+    object_index = 0
+    for g in range(args.groups):
+        group_root = None
+        chain = []
+        for m in range(args.objects):
+            name = f"G{g:04d}_O{m:03d}"
+            obj = bpy.data.objects.new(name, _new_grid_mesh(name, args.verts, rng))
+            bench_coll.objects.link(obj)
+
+            obj.location = (rng.uniform(-50, 50), rng.uniform(-50, 50), rng.uniform(0, 5))
+            obj.rotation_euler = (rng.uniform(0, math.pi), rng.uniform(0, math.pi), rng.uniform(0, math.pi))
+
+            if group_root is None:
+                group_root = obj
+                chain = [obj]
+            else:
+                # Parent inside the group, at most args.depth levels deep
+                parent_level = min(len(chain), max(1, args.depth)) - 1
+                obj.parent = chain[parent_level]
+                if len(chain) < args.depth:
+                    chain.append(obj)
+
+            if args.modifier_every > 0 and object_index % args.modifier_every == 0:
+                obj.modifiers.new("Bench Subsurf", "SUBSURF").levels = 1
+                obj.modifiers.new("Bench Displace", "DISPLACE").strength = 0.05
+
+            objects.append(obj)
+            object_index += 1
+
+    bpy.context.view_layer.update()
+    return objects
+
+
+def _fresh_scene(args, seed):
+    """Load an empty file (firing the addon load handlers) and rebuild the bench scene."""
+    bpy.ops.wm.read_homefile(use_empty=True)
+    return _build_scene(args, random.Random(seed))
+
+
+def _select(objects):
+    for obj in bpy.context.view_layer.objects:
+        obj.select_set(False)
+    for obj in objects:
+        obj.select_set(True)
+    if objects:
+        bpy.context.view_layer.objects.active = objects[0]
+
+
+# ---------------------------------------------------------------------------
+# Benchmarks
+# ---------------------------------------------------------------------------
+
+def _timed(func, *func_args):
+    start = time.perf_counter()
+    func(*func_args)
+    return (time.perf_counter() - start) * 1000.0
+
+
+def _bench_standardize_groups(args, standardize):
+    cold = []
+    warm = []
+    for r in range(args.repeat):
+        objects = _fresh_scene(args, args.seed + r)
+        _select(objects)
+        cold.append(_timed(standardize.standardize_groups, objects, "BASE", "AUTO"))
+        warm.append(_timed(standardize.standardize_groups, objects, "BASE", "AUTO"))
+    return {"standardize_groups_cold": cold, "standardize_groups_warm": warm}
+
+
+def _bench_standardize_object_origins(args, standardize, is_pro):
+    runs = []
+    for r in range(args.repeat):
+        objects = _fresh_scene(args, args.seed + r)
+        mesh_objects = [obj for obj in objects if obj.type == 'MESH']
+        if not is_pro:
+            # Standard edition only classifies a single object per call
+            mesh_objects = mesh_objects[:1]
+        _select(mesh_objects)
+        runs.append(_timed(standardize.standardize_object_origins, mesh_objects, "BASE", "AUTO"))
+    return {"standardize_object_origins": runs}
+
+
+def _bench_organize(args, standardize, organize_op):
+    runs = []
+    for r in range(args.repeat):
+        objects = _fresh_scene(args, args.seed + r)
+        _select(objects)
+        standardize.standardize_groups(objects, "BASE", "AUTO")
+        runs.append(_timed(organize_op))
+    return {"organize": runs}
+
+
+def _bench_depsgraph_storm(args, standardize):
+    """Move random objects one at a time and let the addon handlers react to each update."""
+    objects = _fresh_scene(args, args.seed)
+    _select(objects)
+    standardize.standardize_groups(objects, "BASE", "AUTO")
+
+    rng = random.Random(args.seed)
+    view_layer = bpy.context.view_layer
+    per_update = []
+    start = time.perf_counter()
+    for _ in range(args.updates):
+        obj = rng.choice(objects)
+        obj.location.x += rng.uniform(-0.1, 0.1)
+        per_update.append(_timed(view_layer.update))
+    total = (time.perf_counter() - start) * 1000.0
+    return {"depsgraph_update": per_update, "depsgraph_storm_total": [total]}
+
+
+def _summarize(runs):
+    return {
+        "runs_ms": runs,
+        "min_ms": min(runs),
+        "median_ms": statistics.median(runs),
+        "mean_ms": statistics.fmean(runs),
+        "max_ms": max(runs),
+    }
+
+
+def _peak_rss_kb():
+    """Return (self, children) peak RSS in KiB, or (None, None) where unsupported."""
+    try:
+        import resource
+    except ImportError:
+        return None, None
+    scale = 1.0 / 1024.0 if sys.platform == "darwin" else 1.0  # macOS reports bytes
+    own = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss * scale
+    children = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss * scale
+    return int(own), int(children)
+
+
+def main():
+    args = _parse_args()
+    pivot = _load_modules(args)
+
+    from pivot_lib import edition_utils, instrumentation, shm_utils, standardize
+    import elbo_sdk_rust as engine
+    from pivot.operators.operators import Pivot_OT_Organize_Classified_Objects
+
+    category, op_name = Pivot_OT_Organize_Classified_Objects.bl_idname.split(".")
+    organize_op = getattr(getattr(bpy.ops, category), op_name)
+    is_pro = edition_utils.is_pro_edition()
+
+    if args.chunk_verts is not None:
+        shm_utils.set_upload_chunk_verts(args.chunk_verts)
+    shm_utils.set_direct_copy_enabled(not args.no_direct_copy)
+    if args.fill_threads is not None:
+        shm_utils.set_fill_threads(args.fill_threads)
+
+    instrumentation.reset()
+    timings = {}
+    if is_pro:
+        timings.update(_bench_standardize_groups(args, standardize))
+    timings.update(_bench_standardize_object_origins(args, standardize, is_pro))
+    if is_pro:
+        timings.update(_bench_organize(args, standardize, organize_op))
+        timings.update(_bench_depsgraph_storm(args, standardize))
+
+    stage_totals = instrumentation.get_stage_totals()
+
+    # Stop the engine so its peak RSS is folded into RUSAGE_CHILDREN
+    pivot.unregister()
+    try:
+        engine.stop_engine()
+    except Exception as e:
+        print(f"[Pivot Bench] Could not stop engine: {e}")
+    peak_self_kb, peak_children_kb = _peak_rss_kb()
+
+    report = {
+        "config": {
+            "groups": args.groups,
+            "objects_per_group": args.objects,
+            "verts_per_object": args.verts,
+            "depth": args.depth,
+            "modifier_every": args.modifier_every,
+            "repeat": args.repeat,
+            "updates": args.updates,
+            "seed": args.seed,
+            "chunk_verts": shm_utils.get_upload_chunk_verts(),
+            "direct_copy": shm_utils.get_direct_copy_enabled(),
+            "fill_threads": shm_utils.get_fill_threads(),
+        },
+        "environment": {
+            "blender": bpy.app.version_string,
+            "python": platform.python_version(),
+            "platform": platform.platform(),
+            "edition": "PRO" if is_pro else "STANDARD",
+        },
+        "timings": {name: _summarize(runs) for name, runs in timings.items()},
+        "stages": {name: {"count": count, "total_ms": seconds * 1000.0}
+                   for name, (count, seconds) in stage_totals.items()},
+        "peak_rss_kb": {"blender": peak_self_kb, "engine": peak_children_kb},
+    }
+
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+        print(f"[Pivot Bench] Wrote {args.output}")
+    else:
+        print(text)
+
+
+if __name__ == "__main__":
+    main()
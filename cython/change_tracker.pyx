@@ -0,0 +1,246 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Incremental change tracking for managed groups.
+
+The depsgraph handler feeds every update into the tracker, which turns the
+changed IDs into a set of dirty group names. Membership and orphan checks then
+only look at those groups instead of diffing full snapshots on every update.
+
+Some edits do not name the affected group in ``depsgraph.updates`` (ID
+removal, object and collection renames, links into the scene's master
+collection). These
+raise coarser flags instead. ``structure_changed`` re-checks every group for
+orphaning; ``full_scan`` re-diffs every group's membership. Both are rare
+compared to transform and geometry updates.
+
+While a modal standardize is in flight the tracker also records an edit
+generation per updated ID (begin_watch()/end_watch()), so the job can tell
+which of its groups were edited after their data was sent to the engine.
+"""
+
+import bpy
+
+
+cdef class ChangeSet:
+    """Changes accumulated since the last take_changes() call."""
+
+    cdef public bint full_scan
+    cdef public bint structure_changed
+    # Groups touched by any update
+    cdef public set dirty_groups
+    # Subset whose collection was tagged, i.e. whose membership may have changed
+    cdef public set membership_groups
+
+    def __init__(self, bint full_scan, bint structure_changed, set dirty_groups, set membership_groups) -> None:
+        self.full_scan = full_scan
+        self.structure_changed = structure_changed
+        self.dirty_groups = dirty_groups
+        self.membership_groups = membership_groups
+
+
+cdef class ChangeTracker:
+    """Maintains the dirty group set between depsgraph handler invocations."""
+
+    cdef set _dirty_groups
+    cdef set _membership_groups
+    cdef bint _full_scan
+    cdef bint _structure_changed
+    cdef Py_ssize_t _collection_count
+    cdef Py_ssize_t _object_count
+    # Master collection pointer and its child/object counts, to tell links apart from other scene tags
+    cdef Py_ssize_t _master_pointer
+    cdef Py_ssize_t _master_children
+    cdef Py_ssize_t _master_objects
+    cdef object _msgbus_owner
+    # Edit generations, only recorded while a job is watching
+    cdef bint _watching
+    cdef Py_ssize_t _edit_generation
+    # Generation of the last ID addition or removal, which may touch any group
+    cdef Py_ssize_t _global_edit
+    cdef Py_ssize_t _watch_collection_count
+    cdef Py_ssize_t _watch_object_count
+    # ID pointer (objects, their data, collections) -> generation of its last update
+    cdef dict _edits
+
+    def __init__(self) -> None:
+        self._dirty_groups = set()
+        self._membership_groups = set()
+        self._msgbus_owner = object()
+        self._watching = False
+        self._edit_generation = 0
+        self._global_edit = -1
+        self._edits = {}
+        self.reset()
+
+    cpdef void reset(self):
+        """Forget pending changes; the next take_changes() requests full scans."""
+        self._dirty_groups.clear()
+        self._membership_groups.clear()
+        self._full_scan = True
+        self._structure_changed = True
+        self._collection_count = -1
+        self._object_count = -1
+        self._master_pointer = 0
+        self._master_children = -1
+        self._master_objects = -1
+
+    cpdef void request_full_scan(self):
+        self._full_scan = True
+        self._structure_changed = True
+
+    cpdef void request_structure_scan(self):
+        self._structure_changed = True
+
+    cpdef void mark_group_dirty(self, str group_name):
+        self._dirty_groups.add(group_name)
+
+    # ==================== Edit generations ====================
+
+    cpdef void begin_watch(self):
+        """Start recording per-ID edit generations for an in-flight job."""
+        self._watching = True
+        self._global_edit = -1
+        self._watch_collection_count = len(bpy.data.collections)
+        self._watch_object_count = len(bpy.data.objects)
+        self._edits.clear()
+
+    cpdef void end_watch(self):
+        self._watching = False
+        self._edits.clear()
+
+    cpdef Py_ssize_t get_edit_generation(self):
+        """Generation to compare against; later updates are newer than it."""
+        return self._edit_generation
+
+    cpdef bint edited_since(self, object pointers, Py_ssize_t generation):
+        """True if any of the ID pointers was updated after generation (while watching)."""
+        if self._global_edit > generation:
+            return True
+        for ptr in pointers:
+            if self._edits.get(ptr, -1) > generation:
+                return True
+        return False
+
+    cdef void _record_edits(self, object depsgraph, Py_ssize_t collection_count, Py_ssize_t object_count):
+        self._edit_generation += 1
+        # Removed IDs leave no update behind, so any count change counts against every group
+        if collection_count != self._watch_collection_count or object_count != self._watch_object_count:
+            self._watch_collection_count = collection_count
+            self._watch_object_count = object_count
+            self._global_edit = self._edit_generation
+        for update in depsgraph.updates:
+            id_data = update.id.original
+            if isinstance(id_data, bpy.types.Scene):
+                continue
+            self._edits[id_data.as_pointer()] = self._edit_generation
+
+    cpdef void consume_depsgraph(self, object depsgraph, object group_mgr):
+        """Fold one depsgraph update into the dirty state; O(changed IDs)."""
+        cdef dict sync_state = group_mgr.get_sync_state_dict()
+        cdef object objects_collection = group_mgr.get_objects_collection()
+        cdef Py_ssize_t collection_count = len(bpy.data.collections)
+        cdef Py_ssize_t object_count = len(bpy.data.objects)
+        cdef object id_data
+        cdef object master
+        cdef str name
+
+        if self._watching:
+            self._record_edits(depsgraph, collection_count, object_count)
+
+        # Removals leave no update naming the removed ID behind
+        if collection_count != self._collection_count:
+            self._collection_count = collection_count
+            self._structure_changed = True
+        if object_count != self._object_count:
+            self._object_count = object_count
+            self._full_scan = True
+
+        if self._full_scan:
+            return
+
+        for update in depsgraph.updates:
+            id_data = update.id.original
+            if isinstance(id_data, bpy.types.Object):
+                self._dirty_groups.update(group_mgr.get_object_group_names(id_data))
+            elif isinstance(id_data, bpy.types.Collection):
+                name = id_data.name
+                if name in sync_state:
+                    self._dirty_groups.add(name)
+                    self._membership_groups.add(name)
+                elif id_data == objects_collection:
+                    # Groups may have been linked into or out of the objects collection
+                    self._structure_changed = True
+            elif isinstance(id_data, bpy.types.Scene):
+                # Links into the master collection only tag the scene
+                master = id_data.collection
+                if objects_collection is None or objects_collection == master:
+                    self._check_master_counts(master)
+
+    cdef void _check_master_counts(self, object master):
+        """Raise structure_changed only if the master collection's links changed."""
+        cdef Py_ssize_t pointer = master.as_pointer()
+        cdef Py_ssize_t children = len(master.children)
+        cdef Py_ssize_t objects = len(master.objects)
+        if pointer != self._master_pointer or children != self._master_children or objects != self._master_objects:
+            self._master_pointer = pointer
+            self._master_children = children
+            self._master_objects = objects
+            self._structure_changed = True
+
+    cpdef ChangeSet take_changes(self):
+        """Return the pending changes and start accumulating a new set."""
+        cdef ChangeSet changes = ChangeSet(self._full_scan, self._structure_changed, self._dirty_groups, self._membership_groups)
+        self._dirty_groups = set()
+        self._membership_groups = set()
+        self._full_scan = False
+        self._structure_changed = False
+        return changes
+
+    # ==================== msgbus ====================
+
+    def subscribe(self) -> None:
+        """Request a full scan when any object is renamed (membership is tracked by name).
+
+        Collection renames request a structure scan: a renamed group no longer
+        matches its sync state entry and must be dropped as orphaned.
+        """
+        bpy.msgbus.subscribe_rna(
+            key=(bpy.types.Object, "name"),
+            owner=self._msgbus_owner,
+            args=(),
+            notify=self.request_full_scan,
+            options={'PERSISTENT'},
+        )
+        bpy.msgbus.subscribe_rna(
+            key=(bpy.types.Collection, "name"),
+            owner=self._msgbus_owner,
+            args=(),
+            notify=self.request_structure_scan,
+            options={'PERSISTENT'},
+        )
+
+    def unsubscribe(self) -> None:
+        bpy.msgbus.clear_by_owner(self._msgbus_owner)
+
+
+# Global instance
+cdef ChangeTracker _change_tracker = ChangeTracker()
+
+cpdef ChangeTracker get_change_tracker():
+    """Get the global change tracker instance."""
+    return _change_tracker
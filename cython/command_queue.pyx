@@ -0,0 +1,111 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Coalescing queue for engine group drops.
+
+Handlers record orphaned groups here instead of making a blocking engine
+round trip per depsgraph update. Pending drops are merged (a group dropped
+twice is dropped once) and sent in one drop_groups_command on a short
+bpy.app.timers delay, or earlier by flush() before any command that reads or
+writes engine group state (standardize, organize, classification sync, file
+load).
+
+Bookkeeping on the bridge side (sync state, snapshot, colors) still happens
+immediately; only the engine IPC is deferred.
+"""
+
+import bpy
+import elbo_sdk_rust as engine
+
+from . import engine_state
+from . import engine_task
+
+# Seconds to wait after the first queued drop, so bulk edits coalesce
+cdef double _FLUSH_DELAY = 0.25
+
+
+cdef class CommandQueue:
+    """Pending group drops, flushed in one drop_groups_command."""
+
+    # Insertion-ordered group names (dict keys) awaiting drop_groups_command
+    cdef dict _drops
+    cdef bint _timer_registered
+    # Bound once: bpy.app.timers matches callbacks by identity
+    cdef object _timer_callback
+
+    def __init__(self) -> None:
+        self._drops = {}
+        self._timer_registered = False
+        self._timer_callback = self._on_timer
+
+    cpdef void queue_drops(self, object group_names):
+        cdef str name
+        for name in group_names:
+            self._drops[name] = None
+        self._schedule()
+
+    cpdef bint has_pending(self):
+        return bool(self._drops)
+
+    cpdef void clear(self):
+        """Forget pending drops (the engine is stopping or its state was discarded)."""
+        self._drops.clear()
+
+    cpdef bint flush(self):
+        """Send pending drops now; returns False if an engine task is in flight."""
+        cdef list drops
+        if not self.has_pending():
+            return True
+        if engine_task.has_active_task():
+            return False
+
+        drops = list(self._drops)
+        self._drops = {}
+        try:
+            dropped_count = engine_state.timed_command("drop_groups_command", engine.drop_groups_command, drops)
+            engine_state.forget_group_uploads(drops)
+            print(f"[Pivot] Dropped {dropped_count} orphaned groups from engine")
+        except Exception as e:
+            print(f"[Pivot] Error dropping groups from engine: {e}")
+        return True
+
+    cdef void _schedule(self):
+        if self._timer_registered or not self.has_pending():
+            return
+        self._timer_registered = True
+        bpy.app.timers.register(self._timer_callback, first_interval=_FLUSH_DELAY)
+
+    def _on_timer(self):
+        if not self.flush():
+            # Retry once the in-flight engine task has been collected
+            return _FLUSH_DELAY
+        self._timer_registered = False
+        return None
+
+    def unregister_timer(self) -> None:
+        """Remove the pending flush timer (file load drops non-persistent timers anyway)."""
+        if self._timer_registered and bpy.app.timers.is_registered(self._timer_callback):
+            bpy.app.timers.unregister(self._timer_callback)
+        self._timer_registered = False
+
+
+# Global instance
+cdef CommandQueue _command_queue = CommandQueue()
+
+cpdef CommandQueue get_command_queue():
+    """Get the global command queue instance."""
+    return _command_queue
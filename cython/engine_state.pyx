@@ -24,14 +24,58 @@ about how Blender-side edits diverge from the engine.
 
 from typing import Dict, Iterable, Mapping, Set
 
+import os
+from time import perf_counter
+
+import numpy as np
+cimport numpy as cnp
+from libc.stdint cimport int32_t, uint64_t
+
 cdef str _engine_license_mode = "UNKNOWN"
 
-# Membership snapshot returned by the engine: group name -> set of object names.
-cdef dict _group_membership_snapshot = {}
+# Membership snapshot of what the engine was sent: group name -> sorted, read-only
+# int32 array of interned object IDs. Object names are interned once per file
+# (membership is tracked by name; renames trigger a full scan).
+cdef dict _object_ids = {}
+cdef list _object_names = []
+cdef dict _group_member_ids = {}
+
+# Bumped on every membership change; per-group versions record the last
+# change (or drop) so callers can ask what changed since a version they saw.
+cdef uint64_t _snapshot_version = 0
+cdef dict _group_versions = {}
+cdef dict _dropped_versions = {}
+
+# Geometry fingerprints of the meshes last uploaded to the engine, keyed by
+# Object.as_pointer() like the group manager's reverse index:
+# pointer -> (vert count, edge count, crc32 of the float32 ``co`` buffer).
+cdef dict _object_fingerprints = {}
+# group name -> pointers it uploaded, and pointer -> number of groups holding it,
+# so dropping a group forgets the fingerprints no other group still holds
+cdef dict _group_fingerprint_members = {}
+cdef dict _fingerprint_refs = {}
+
+# Geometry bytes sent per group (what was actually written to SHM, so
+# POINTS/SAMPLED uploads count their reduced size). Entries leave only when
+# the engine confirmed the drop or stopped, so a leak across drop cycles shows.
+cdef dict _group_upload_bytes = {}
+cdef uint64_t _uploaded_bytes = 0
 
 # Flag to indicate if classification is in progress
 cdef bint _is_performing_classification = False
 
+# Command latency histograms: command name -> [count, total s, max s, bucket counts].
+# Bucket i counts calls of at most _LATENCY_BUCKETS[i] seconds; the last is unbounded.
+_LATENCY_BUCKETS = (0.001, 0.004, 0.016, 0.064, 0.25, 1.0, 4.0, 16.0, float("inf"))
+cdef dict _command_latency = {}
+cdef int _commands_in_flight = 0
+
+# Engine process lookup and the last stats read, reused for _STATS_MAX_AGE seconds
+cdef int _engine_pid = 0
+cdef object _cached_stats = None
+cdef double _cached_stats_time = 0.0
+cdef double _STATS_MAX_AGE = 1.0
+
 
 # ---------------------------------------------------------------------------
 # License helpers
@@ -67,6 +111,33 @@ def is_performing_classification() -> bint:
 # Membership snapshot APIs
 # ---------------------------------------------------------------------------
 
+cdef int32_t _intern(str name):
+    cdef object object_id = _object_ids.get(name)
+    if object_id is None:
+        object_id = len(_object_names)
+        _object_ids[name] = object_id
+        _object_names.append(name)
+    return object_id
+
+
+cdef cnp.ndarray _member_array(object members, bint intern):
+    """Sorted unique IDs for member names; None if intern is False and a name is unknown."""
+    cdef list ids = []
+    cdef object object_id
+    cdef cnp.ndarray result
+    for name in members:
+        if intern:
+            ids.append(_intern(name))
+        else:
+            object_id = _object_ids.get(name)
+            if object_id is None:
+                return None
+            ids.append(object_id)
+    result = np.unique(np.array(ids, dtype=np.int32))
+    result.setflags(write=False)
+    return result
+
+
 def update_group_membership_snapshot(snapshot: Mapping[str, Iterable[str]], *, bint replace = False) -> None:
     """Persist the engine-reported membership snapshot.
 
@@ -74,15 +145,28 @@ def update_group_membership_snapshot(snapshot: Mapping[str, Iterable[str]], *, b
         snapshot: Mapping of group name -> iterable of object names the engine used.
         replace:  When True, discard all prior snapshot data before applying updates.
     """
-    global _group_membership_snapshot
+    global _snapshot_version
+    cdef cnp.ndarray ids
+    cdef cnp.ndarray previous
 
     if replace:
-        drop_groups_from_snapshot(list(_group_membership_snapshot.keys()))
-        _group_membership_snapshot.clear()
+        drop_groups_from_snapshot(list(_group_member_ids.keys()))
+        _group_member_ids.clear()
+        if not snapshot:
+            # Full reset (file load): nothing references the interned names any more
+            _object_ids.clear()
+            del _object_names[:]
+            _group_versions.clear()
+            _dropped_versions.clear()
 
     for name, members in snapshot.items():
-        member_set = set(members)
-        _group_membership_snapshot[name] = member_set
+        ids = _member_array(members, True)
+        previous = _group_member_ids.get(name)
+        _group_member_ids[name] = ids
+        _dropped_versions.pop(name, None)
+        if previous is None or not np.array_equal(previous, ids):
+            _snapshot_version += 1
+            _group_versions[name] = _snapshot_version
 
 
 def build_group_membership_snapshot(list full_groups, list group_names) -> dict:
@@ -108,11 +192,290 @@ def build_group_membership_snapshot(list full_groups, list group_names) -> dict:
 
 
 def get_group_membership_snapshot() -> Dict[str, Set[str]]:
-    """Return a deep copy of the engine membership snapshot."""
-    return {name: set(members) for name, members in _group_membership_snapshot.items()}
+    """Return a name-based copy of the whole snapshot (debugging; handlers use the typed API)."""
+    return {name: {_object_names[i] for i in ids} for name, ids in _group_member_ids.items()}
+
+
+def has_group_members(str group_name) -> bool:
+    """Return True if the group's membership was uploaded to the engine."""
+    return group_name in _group_member_ids
+
+
+def get_group_member_ids(str group_name):
+    """Return the group's read-only sorted ID array, or None if it was never uploaded."""
+    return _group_member_ids.get(group_name)
+
+
+def get_group_member_count(str group_name) -> int:
+    """Return the number of members the engine holds for a group, or -1 if unknown."""
+    ids = _group_member_ids.get(group_name)
+    return -1 if ids is None else len(ids)
+
+
+def group_members_match(str group_name, object member_names) -> bool:
+    """Return True if member_names is exactly the membership the engine holds.
+
+    Names are looked up without interning, so an object the engine never saw
+    short-circuits to False without touching the arrays.
+    """
+    cdef cnp.ndarray expected = _group_member_ids.get(group_name)
+    cdef cnp.ndarray current
+    if expected is None or len(member_names) != len(expected):
+        return False
+    current = _member_array(member_names, False)
+    return current is not None and np.array_equal(current, expected)
+
+
+def get_object_name(int32_t object_id) -> str:
+    return _object_names[object_id]
+
+
+def get_snapshot_version() -> int:
+    """Return the current membership version; O(1)."""
+    return _snapshot_version
+
+
+def get_groups_changed_since(uint64_t version) -> tuple:
+    """Return (changed, dropped) group name sets whose membership moved after version."""
+    cdef set changed = {name for name, v in _group_versions.items() if v > version}
+    cdef set dropped = {name for name, v in _dropped_versions.items() if v > version}
+    return changed, dropped
 
 
 def drop_groups_from_snapshot(group_names: Iterable[str]) -> None:
     """Remove groups that are no longer managed by Pivot."""
+    global _snapshot_version
     for name in group_names:
-        _group_membership_snapshot.pop(name, None)
+        if _group_member_ids.pop(name, None) is not None:
+            _snapshot_version += 1
+            _group_versions.pop(name, None)
+            _dropped_versions[name] = _snapshot_version
+
+
+# ---------------------------------------------------------------------------
+# Geometry fingerprint APIs
+# ---------------------------------------------------------------------------
+
+cdef void _release_fingerprints(object pointers):
+    cdef int refs
+    for ptr in pointers:
+        refs = _fingerprint_refs.get(ptr, 0) - 1
+        if refs > 0:
+            _fingerprint_refs[ptr] = refs
+        else:
+            _fingerprint_refs.pop(ptr, None)
+            _object_fingerprints.pop(ptr, None)
+
+
+def update_object_fingerprints(group_fingerprints: Mapping[str, Mapping[int, tuple]]) -> None:
+    """Record the fingerprints of meshes just uploaded, per group (name -> {pointer: fingerprint})."""
+    cdef set members
+    for name, fingerprints in group_fingerprints.items():
+        members = set(fingerprints)
+        previous = _group_fingerprint_members.get(name)
+        if previous is not None:
+            _release_fingerprints(previous)
+        for ptr in members:
+            _fingerprint_refs[ptr] = _fingerprint_refs.get(ptr, 0) + 1
+        _group_fingerprint_members[name] = members
+        _object_fingerprints.update(fingerprints)
+
+
+def drop_group_fingerprints(group_names: Iterable[str]) -> None:
+    """Forget the fingerprints of dropped or orphaned groups' members."""
+    for name in group_names:
+        members = _group_fingerprint_members.pop(name, None)
+        if members is not None:
+            _release_fingerprints(members)
+
+
+# ---------------------------------------------------------------------------
+# Uploaded geometry accounting
+# ---------------------------------------------------------------------------
+
+def record_group_uploads(group_bytes: Mapping[str, int]) -> None:
+    """Record the geometry bytes just sent for each group, replacing earlier uploads."""
+    global _uploaded_bytes
+    for name, sent in group_bytes.items():
+        _uploaded_bytes -= _group_upload_bytes.get(name, 0)
+        _group_upload_bytes[name] = sent
+        _uploaded_bytes += sent
+
+
+def forget_group_uploads(group_names: Iterable[str]) -> None:
+    """Subtract groups the engine confirmed it dropped."""
+    global _uploaded_bytes
+    for name in group_names:
+        _uploaded_bytes -= _group_upload_bytes.pop(name, 0)
+
+
+def clear_group_uploads() -> None:
+    """Forget every upload (the engine process stopped)."""
+    global _uploaded_bytes
+    _group_upload_bytes.clear()
+    _uploaded_bytes = 0
+
+
+def get_object_fingerprint(object object_pointer):
+    """Return the last uploaded fingerprint for an Object.as_pointer(), or None if unknown."""
+    return _object_fingerprints.get(object_pointer)
+
+
+def clear_object_fingerprints() -> None:
+    """Forget all uploaded fingerprints (the engine no longer holds the data, or pointers moved)."""
+    _object_fingerprints.clear()
+    _group_fingerprint_members.clear()
+    _fingerprint_refs.clear()
+
+
+# ---------------------------------------------------------------------------
+# Engine telemetry
+# ---------------------------------------------------------------------------
+#
+# The engine reports nothing about itself, so these stats are assembled on the
+# bridge side: latencies are timed around each command, cached groups and
+# bytes come from what the bridge uploaded, and memory and SHM mappings are
+# read from /proc (Linux only; None elsewhere).
+
+def begin_command() -> None:
+    """Mark an engine command as in flight (called on the thread issuing it)."""
+    global _commands_in_flight
+    _commands_in_flight += 1
+
+
+def end_command(str command, double seconds) -> None:
+    """Record one engine command's latency and clear its in-flight mark."""
+    global _commands_in_flight
+    cdef list entry = _command_latency.get(command)
+    cdef Py_ssize_t bucket = 0
+    if _commands_in_flight > 0:
+        _commands_in_flight -= 1
+    if entry is None:
+        entry = [0, 0.0, 0.0, [0] * len(_LATENCY_BUCKETS)]
+        _command_latency[command] = entry
+    while seconds > _LATENCY_BUCKETS[bucket]:
+        bucket += 1
+    entry[0] += 1
+    entry[1] += seconds
+    entry[2] = max(entry[2], seconds)
+    entry[3][bucket] += 1
+
+
+def timed_command(str command, func, *args):
+    """Call a blocking engine command and record its latency."""
+    cdef double start = perf_counter()
+    begin_command()
+    try:
+        return func(*args)
+    finally:
+        end_command(command, perf_counter() - start)
+
+
+def get_command_latency() -> dict:
+    """Return command name -> {count, total, max, buckets} (buckets align with _LATENCY_BUCKETS)."""
+    return {
+        name: {"count": entry[0], "total": entry[1], "max": entry[2], "buckets": list(entry[3])}
+        for name, entry in _command_latency.items()
+    }
+
+
+def get_latency_bucket_bounds() -> tuple:
+    return _LATENCY_BUCKETS
+
+
+def reset_command_latency() -> None:
+    _command_latency.clear()
+
+
+cdef bint _is_child_of(int pid, int parent):
+    try:
+        with open(f"/proc/{pid}/stat") as f:
+            # The command name may contain spaces; fields resume after its closing paren
+            fields = f.read().rsplit(")", 1)[1].split()
+        return int(fields[1]) == parent
+    except (OSError, IndexError, ValueError):
+        return False
+
+
+cdef int _find_engine_pid(str engine_dir):
+    """Return the pid of Blender's child process running from engine_dir, or 0."""
+    global _engine_pid
+    cdef int parent = os.getpid()
+    cdef int pid
+    if _engine_pid and _is_child_of(_engine_pid, parent):
+        return _engine_pid
+    _engine_pid = 0
+    try:
+        entries = os.listdir("/proc")
+    except OSError:
+        return 0
+    engine_dir = os.path.realpath(engine_dir) if engine_dir else ""
+    for name in entries:
+        if not name.isdigit():
+            continue
+        pid = int(name)
+        if not _is_child_of(pid, parent):
+            continue
+        if engine_dir:
+            try:
+                if not os.path.realpath(f"/proc/{pid}/exe").startswith(engine_dir):
+                    continue
+            except OSError:
+                continue
+        _engine_pid = pid
+        break
+    return _engine_pid
+
+
+cdef object _read_resident_bytes(int pid):
+    try:
+        with open(f"/proc/{pid}/status") as f:
+            for line in f:
+                if line.startswith("VmRSS:"):
+                    return int(line.split()[1]) * 1024
+    except (OSError, IndexError, ValueError):
+        pass
+    return None
+
+
+cdef object _count_shm_mappings(int pid):
+    """Count distinct /dev/shm files mapped by pid."""
+    cdef set segments = set()
+    try:
+        with open(f"/proc/{pid}/maps") as f:
+            for line in f:
+                index = line.find("/dev/shm/")
+                if index >= 0:
+                    segments.add(line[index:].rstrip("\n"))
+    except OSError:
+        return None
+    return len(segments)
+
+
+def get_engine_stats(str engine_dir="", bint refresh=False) -> dict:
+    """Return a telemetry snapshot of the engine process and what the bridge keeps in it.
+
+    Keys: pid, resident_bytes, shm_segments (None when not readable), bridge_shm_segments,
+    cached_groups, cached_bytes (groups and geometry bytes sent and not yet confirmed
+    dropped), commands_in_flight and latency (see get_command_latency).
+    Process reads are reused for up to a second so panels can call this on every redraw.
+    """
+    global _cached_stats, _cached_stats_time
+    cdef double now = perf_counter()
+    cdef int pid
+    if refresh or _cached_stats is None or now - _cached_stats_time > _STATS_MAX_AGE:
+        pid = _find_engine_pid(engine_dir)
+        _cached_stats = {
+            "pid": pid or None,
+            "resident_bytes": _read_resident_bytes(pid) if pid else None,
+            "shm_segments": _count_shm_mappings(pid) if pid else None,
+            "bridge_shm_segments": _count_shm_mappings(os.getpid()),
+        }
+        _cached_stats_time = now
+
+    stats = dict(_cached_stats)
+    stats["cached_groups"] = len(_group_upload_bytes)
+    stats["cached_bytes"] = _uploaded_bytes
+    stats["commands_in_flight"] = _commands_in_flight
+    stats["latency"] = get_command_latency()
+    return stats
@@ -0,0 +1,129 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Background engine calls.
+
+An EngineTask runs a blocking engine call (``finalize()`` and the other
+``*_command`` functions) on a worker thread so Blender's UI thread can keep
+handling events. The callable must not touch bpy: all Blender data is read
+before submission and written after completion, on the main thread.
+
+At most one task is active at a time; the engine processes commands in order
+and handlers check ``has_active_task()`` before issuing their own commands.
+"""
+
+import threading
+from time import perf_counter
+
+from . import engine_state
+
+cdef object _active_task = None
+
+
+cdef class EngineTask:
+    """A single engine call running on a worker thread."""
+
+    cdef object _func
+    cdef tuple _args
+    # Latency histogram key (the callable's name)
+    cdef str _command
+    cdef object _thread
+    cdef object _result
+    cdef object _error
+    cdef bint _cancelled
+    cdef double _started
+    cdef double _elapsed
+
+    def __init__(self, func, *args) -> None:
+        self._func = func
+        self._args = args
+        self._command = getattr(func, "__name__", "engine_call").lstrip("_")
+        self._thread = None
+        self._result = None
+        self._error = None
+        self._cancelled = False
+        self._started = 0.0
+        self._elapsed = 0.0
+
+    def _run(self) -> None:
+        try:
+            self._result = self._func(*self._args)
+        except BaseException as e:
+            self._error = e
+        self._elapsed = perf_counter() - self._started
+        engine_state.end_command(self._command, self._elapsed)
+
+    def start(self) -> EngineTask:
+        """Start the worker thread; raises if another task is still running."""
+        global _active_task
+        if _active_task is not None and not (<EngineTask>_active_task).done():
+            raise RuntimeError("Another engine operation is still running")
+        _active_task = self
+        self._started = perf_counter()
+        engine_state.begin_command()
+        self._thread = threading.Thread(target=self._run, name="pivot-engine-task", daemon=True)
+        self._thread.start()
+        return self
+
+    def done(self) -> bool:
+        """Return True once the engine call has returned (or failed)."""
+        return self._thread is not None and not self._thread.is_alive()
+
+    def wait(self, timeout=None) -> bool:
+        """Block until the call returns; returns done()."""
+        if self._thread is not None:
+            self._thread.join(timeout)
+        return self.done()
+
+    def cancel(self) -> None:
+        """Discard the result. The engine call itself cannot be interrupted."""
+        self._cancelled = True
+
+    def cancelled(self) -> bool:
+        return self._cancelled
+
+    def elapsed(self) -> float:
+        """Seconds spent in the call, or so far if it is still running."""
+        if self.done():
+            return self._elapsed
+        if self._thread is None:
+            return 0.0
+        return perf_counter() - self._started
+
+    def result(self):
+        """Return the call's result, re-raising any error from the worker."""
+        global _active_task
+        if not self.done():
+            raise RuntimeError("Engine operation has not finished")
+        if _active_task is self:
+            _active_task = None
+        if self._error is not None:
+            raise self._error
+        return self._result
+
+
+def has_active_task() -> bool:
+    """Return True while a submitted engine call has not been collected."""
+    return _active_task is not None and not (<EngineTask>_active_task).done()
+
+
+def wait_for_active_task() -> None:
+    """Block until any in-flight engine call returns (used before stopping the engine)."""
+    global _active_task
+    if _active_task is not None:
+        (<EngineTask>_active_task).wait()
+        _active_task = None
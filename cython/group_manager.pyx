@@ -23,11 +23,20 @@ Responsibilities:
 - Handle group membership operations
 - Provide group-related queries and utilities
 - Track name changes for managed groups
+- Maintain a reverse object -> group index for O(1) lookups
 """
 
 import bpy
+import json
 from typing import Any, Dict, Iterator, Optional, Set
 
+# Scene custom property holding the managed group list across save/load.
+# Only the bridge's bookkeeping is stored: the engine's per-group hulls, COGs,
+# surface types and fingerprints are not serialised, so a reopened file must
+# re-upload every group before standardize_synced_groups_command can run.
+BRIDGE_STATE_PROP = "pivot_bridge_state"
+cdef int _BRIDGE_STATE_VERSION = 1
+
 cdef class GroupManager:
     """Manages group collections and their metadata with integrated sync state."""
 
@@ -36,9 +45,18 @@ cdef class GroupManager:
     cdef dict _name_tracker
     cdef object _subscription_owner
     cdef object _name_change_callback
+    cdef set _color_dirty
+    # Reverse index keyed by Object.as_pointer(): pointer -> [group names],
+    # and group name -> set of member pointers. Pointers change on undo, so
+    # the index is rebuilt by reindex_groups() whenever IDs may have moved.
+    cdef dict _object_groups
+    cdef dict _group_members
 
     def __init__(self) -> None:
         self._sync_state = {}
+        self._color_dirty = set()
+        self._object_groups = {}
+        self._group_members = {}
         self._last_origin_base_state = {}
         self._name_tracker = {}
         self._subscription_owner = object()  # Owner object for msgbus subscriptions
@@ -72,6 +90,9 @@ cdef class GroupManager:
             pass
         
         self._sync_state.clear()
+        self._color_dirty.clear()
+        self._object_groups.clear()
+        self._group_members.clear()
         self._name_tracker.clear()
         self._last_origin_base_state.clear()
         # Keep the same subscription_owner to avoid memory leaks from orphaned msgbus subscriptions
@@ -84,16 +105,66 @@ cdef class GroupManager:
         return objects_collection if objects_collection else bpy.context.scene.collection
 
     cpdef str get_group_name(self, obj):
-        """Get the group name for an object from its collections."""
-        collections = getattr(obj, "users_collection", None)
-        if not collections:
+        """Get the group name for an object from the reverse index."""
+        cdef list names = self._object_groups.get(obj.as_pointer())
+        if not names:
             return None
-        
-        cdef object coll
-        for coll in collections:
-            if coll.name in self._sync_state:
-                return coll.name
-        return None
+        return names[0]
+
+    cpdef list get_object_group_names(self, obj):
+        """Return the managed groups containing obj (empty if none). Do not modify."""
+        cdef list names = self._object_groups.get(obj.as_pointer())
+        return names if names is not None else []
+
+    cpdef bint is_object_in_group(self, obj, str group_name):
+        cdef set members = self._group_members.get(group_name)
+        return members is not None and obj.as_pointer() in members
+
+    # ==================== Reverse Index ====================
+
+    cdef void _unindex_group(self, str group_name):
+        cdef set members = self._group_members.pop(group_name, None)
+        cdef list names
+        if not members:
+            return
+        for ptr in members:
+            names = self._object_groups.get(ptr)
+            if names is None:
+                continue
+            if group_name in names:
+                names.remove(group_name)
+            if not names:
+                del self._object_groups[ptr]
+
+    cdef void _index_group(self, str group_name):
+        cdef set members = set()
+        cdef list names
+        self._unindex_group(group_name)
+        coll = bpy.data.collections.get(group_name)
+        if coll is None:
+            return
+        for obj in coll.objects:
+            ptr = obj.as_pointer()
+            members.add(ptr)
+            names = self._object_groups.get(ptr)
+            if names is None:
+                self._object_groups[ptr] = [group_name]
+            elif group_name not in names:
+                names.append(group_name)
+        self._group_members[group_name] = members
+
+    cpdef void reindex_groups(self, object group_names=None):
+        """Refresh the reverse index for the given managed groups (all when None)."""
+        cdef str name
+        if group_names is None:
+            self._object_groups.clear()
+            self._group_members.clear()
+            group_names = list(self._sync_state.keys())
+        for name in group_names:
+            if name in self._sync_state:
+                self._index_group(name)
+            else:
+                self._unindex_group(name)
 
     def iter_group_collections(self) -> Iterator[Any]:
         """Yield all collections that are in the managed collections set."""
@@ -101,6 +172,13 @@ cdef class GroupManager:
             if coll_name in bpy.data.collections:
                 yield bpy.data.collections[coll_name]
 
+    def get_group_members(self, str group_name) -> Optional[Set[str]]:
+        """Return the object names currently in one group, or None if its collection is gone."""
+        coll = bpy.data.collections.get(group_name)
+        if coll is None:
+            return None
+        return {obj.name for obj in coll.objects}
+
     def get_group_membership_snapshot(self) -> Dict[str, Set[str]]:
         """Return current group memberships from Blender collections."""
         snapshot = {}
@@ -119,10 +197,24 @@ cdef class GroupManager:
                 return True
         return False
 
+    cpdef void mark_colors_dirty(self):
+        """Re-check every group's color on the next update_colors() call."""
+        self._color_dirty.update(self._sync_state.keys())
+
     def update_colors(self) -> None:
-        """Update color tags for collections based on sync state."""
-        for coll in self.iter_group_collections():
-            synced = self._sync_state.get(coll.name)
+        """Update color tags for groups whose sync state or color tag changed since the last call."""
+        cdef set pending
+        if not self._color_dirty:
+            return
+        pending = self._color_dirty
+        self._color_dirty = set()
+        for name in pending:
+            if name not in self._sync_state:
+                continue
+            coll = bpy.data.collections.get(name)
+            if coll is None:
+                continue
+            synced = self._sync_state.get(name)
 
             # 1. Determine the color that it *should* be.
             correct_color = 'COLOR_04' if synced else 'COLOR_03'
@@ -132,16 +224,18 @@ cdef class GroupManager:
                 # 3. Only perform the expensive write operation if it's wrong.
                 coll.color_tag = correct_color
 
-    def update_orphaned_groups(self) -> None:
+    def update_orphaned_groups(self, group_names=None) -> None:
         """Detect and immediately handle orphaned groups.
         
         Returns a list of orphaned group names that should be deleted from the engine.
         Orphaned groups are: collections that were deleted or moved outside Objects.
+        When group_names is given only those groups are checked.
         """
         orphaned = []
         objects_collection = self.get_objects_collection()
         
-        for coll_name in list(self._sync_state.keys()):
+        candidates = list(self._sync_state.keys()) if group_names is None else [n for n in group_names if n in self._sync_state]
+        for coll_name in candidates:
             if coll_name not in bpy.data.collections:
                 orphaned.append(coll_name)
                 continue
@@ -177,6 +271,13 @@ cdef class GroupManager:
                 args=(collection, self),
                 notify=self._name_change_callback,
             )
+            # Color tag edits don't tag the depsgraph, so correct them from here
+            bpy.msgbus.subscribe_rna(
+                key=collection.path_resolve("color_tag", False),
+                owner=self._subscription_owner,
+                args=(collection,),
+                notify=self._on_color_tag_changed,
+            )
             
             self._name_tracker[collection] = collection_name
             # print(f"[Pivot] Successfully subscribed to '{collection_name}'")
@@ -186,6 +287,16 @@ cdef class GroupManager:
             import traceback
             traceback.print_exc()
 
+    def _on_color_tag_changed(self, collection: Any) -> None:
+        """Restore a managed group's sync color after it was changed by hand."""
+        try:
+            name = collection.name
+        except ReferenceError:
+            return
+        if name in self._sync_state:
+            self._color_dirty.add(name)
+            self.update_colors()
+
     def _unsubscribe_group(self, group_name: str) -> None:
         """Unsubscribe from name changes for a specific group name."""
         # Find and remove the collection from tracker by name
@@ -208,12 +319,16 @@ cdef class GroupManager:
         for name in group_names:
             if name and name not in self._sync_state:
                 self._sync_state[name] = True
+                self._color_dirty.add(name)
                 self._last_origin_base_state.setdefault(name, True)
                 
                 # Subscribe to name changes when group is added
                 if name in bpy.data.collections:
                     collection = bpy.data.collections[name]
                     self._subscribe_to_group(collection)
+            if name:
+                # Membership of re-standardized groups may have changed too
+                self._index_group(name)
 
     cpdef set get_managed_group_names_set(self):
         """Return the set of all managed collection names."""
@@ -233,6 +348,7 @@ cdef class GroupManager:
                 del self._sync_state[name]
                 if name in self._last_origin_base_state:
                     del self._last_origin_base_state[name]
+                self._unindex_group(name)
                 # Unsubscribe when group is dropped
                 self._unsubscribe_group(name)
         print("Remaining state",self._sync_state)
@@ -245,15 +361,17 @@ cdef class GroupManager:
 
     cpdef void set_group_unsynced(self, str group_name):
         """Mark a group as unsynced (only if it already exists in sync state)."""
-        if group_name and group_name in self._sync_state:
+        if group_name and group_name in self._sync_state and self._sync_state[group_name]:
             self._sync_state[group_name] = False
+            self._color_dirty.add(group_name)
 
     cpdef void set_groups_synced(self, list group_names):
         """Mark groups as synced (only if they already exist in sync state)."""
         cdef str name
         for name in group_names:
-            if name and name in self._sync_state:
+            if name and name in self._sync_state and not self._sync_state[name]:
                 self._sync_state[name] = True
+                self._color_dirty.add(name)
 
     cpdef void set_groups_last_origin_method_base(self, list group_names, bint used_base):
         """Record whether each managed group was last transformed with the BASE origin method."""
@@ -279,6 +397,48 @@ cdef class GroupManager:
             return True
         return self.was_group_last_transformed_using_base(group_name)
 
+    # ==================== Persistence ====================
+
+    def save_state(self, scene) -> None:
+        """Store the managed group names and origin method state on the scene.
+
+        The engine's copy of each group does not survive a restart, so only the
+        bridge's bookkeeping is saved; restored groups come back unsynced.
+        """
+        groups = {name: self._last_origin_base_state.get(name, True) for name in self._sync_state}
+        if not groups:
+            if BRIDGE_STATE_PROP in scene:
+                del scene[BRIDGE_STATE_PROP]
+            return
+        scene[BRIDGE_STATE_PROP] = json.dumps(
+            {"version": _BRIDGE_STATE_VERSION, "groups": groups}, separators=(",", ":"))
+
+    def restore_state(self, scene) -> list:
+        """Re-adopt the groups saved by save_state(); returns the restored names."""
+        cdef list restored = []
+        blob = scene.get(BRIDGE_STATE_PROP)
+        if not blob:
+            return restored
+        try:
+            state = json.loads(blob)
+        except (TypeError, ValueError):
+            return restored
+        if state.get("version") != _BRIDGE_STATE_VERSION:
+            return restored
+
+        collections = bpy.data.collections
+        for name, used_base in state.get("groups", {}).items():
+            collection = collections.get(name)
+            if collection is None:
+                continue
+            self._sync_state[name] = False
+            self._last_origin_base_state[name] = bool(used_base)
+            self._color_dirty.add(name)
+            self._subscribe_to_group(collection)
+            self._index_group(name)
+            restored.append(name)
+        return restored
+
     cpdef dict get_sync_state(self):
         """Return a copy of the full sync state dict (group_name -> synced bool)."""
         return dict(self._sync_state)
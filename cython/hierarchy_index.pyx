@@ -0,0 +1,349 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Shared index of the collection tree under a scene root.
+
+Selection aggregation and operator polls both need to know which top-level
+collection owns a nested collection, whether a top holds any mesh, which
+collections an object sits in and which objects are a collection's roots.
+The index walks each root's tree once and answers those queries from dicts.
+
+Collection updates and ID count changes invalidate the whole index, a scene
+update drops the tree of its master collection, and a parent change on an
+indexed object (seen through the depsgraph) only drops the cached root lists.
+
+Without a depsgraph feed (set_tracking(False), used by the Standard edition,
+which registers no depsgraph handler) every query batch rebuilds from
+scratch, like the walks it replaces.
+
+Per-object qualification results and the poll's "any qualifying" answer are
+cached on top of the trees. A generation counter, bumped on every
+invalidation, tells the poll cache whether its answer is still valid.
+"""
+
+import bpy
+
+# Constants (must match pivot/surface_manager.py)
+CLASSIFICATION_MARKER_PROP = "pivot_is_classification_collection"
+CLASSIFICATION_ROOT_MARKER_PROP = "pivot_is_classification_root"
+
+
+cdef inline bint _is_classification(object coll):
+    return bool(coll.get(CLASSIFICATION_MARKER_PROP, False) or coll.get(CLASSIFICATION_ROOT_MARKER_PROP, False))
+
+
+cdef class _TreeIndex:
+    """Lookup tables for the tree under one root collection, keyed by as_pointer()."""
+
+    cdef object root
+    # nested collection -> top-level collections that own it
+    cdef dict coll_to_tops
+    # top-level collection -> True if any object in its subtree is a mesh
+    cdef dict top_has_mesh
+    # object -> collections under the root (including the root) that link it
+    cdef dict object_colls
+    # collection -> parentless objects in its subtree, filled on demand
+    cdef dict roots
+    # indexed object -> its parent's pointer (0 for none), to notice reparenting
+    cdef dict parents
+    # object -> cached qualifies() result, cleared when anything is reparented
+    cdef dict qualified
+    # Direct contents of the root; scene updates only matter if these change
+    cdef Py_ssize_t root_object_count
+    cdef Py_ssize_t root_child_count
+
+    def __init__(self, object root) -> None:
+        self.root = root
+        self.coll_to_tops = {}
+        self.top_has_mesh = {}
+        self.object_colls = {}
+        self.roots = {}
+        self.parents = {}
+        self.qualified = {}
+        self.root_object_count = len(root.objects)
+        self.root_child_count = len(root.children)
+        self._build()
+
+    cdef void _link_objects(self, object coll):
+        cdef object key
+        cdef list colls
+        for obj in coll.objects:
+            key = obj.as_pointer()
+            colls = self.object_colls.get(key)
+            if colls is None:
+                self.object_colls[key] = [coll]
+                self.parents[key] = obj.parent.as_pointer() if obj.parent is not None else 0
+            elif coll not in colls:
+                colls.append(coll)
+
+    cdef void _build(self):
+        cdef list stack
+        cdef list subtree
+        cdef bint invalid_found
+        cdef bint has_mesh
+        cdef object current
+        cdef list tops
+
+        self._link_objects(self.root)
+        for top in self.root.children:
+            if _is_classification(top):
+                continue
+            # A top is skipped entirely if any collection below it is a classification collection
+            invalid_found = False
+            has_mesh = False
+            subtree = []
+            stack = [top]
+            while stack:
+                current = stack.pop()
+                if _is_classification(current):
+                    invalid_found = True
+                    break
+                subtree.append(current)
+                stack.extend(current.children)
+            if invalid_found:
+                continue
+
+            for current in subtree:
+                tops = self.coll_to_tops.get(current.as_pointer())
+                if tops is None:
+                    self.coll_to_tops[current.as_pointer()] = [top]
+                elif top not in tops:
+                    tops.append(top)
+                self._link_objects(current)
+                if not has_mesh:
+                    for obj in current.objects:
+                        if obj.type == 'MESH':
+                            has_mesh = True
+                            break
+            self.top_has_mesh[top.as_pointer()] = has_mesh
+
+    cdef bint qualifies(self, object obj):
+        cdef object key = obj.as_pointer()
+        cdef object cached = self.qualified.get(key)
+        cdef bint result
+        if cached is not None:
+            return cached
+        result = self._qualifies(obj, self.object_colls.get(key))
+        self.qualified[key] = result
+        return result
+
+    cdef bint _qualifies(self, object obj, list colls):
+        cdef list stack
+        cdef list tops
+        cdef object current
+        if not colls:
+            return False
+        for coll in colls:
+            if coll == self.root:
+                if obj.type == 'MESH':
+                    return True
+                stack = list(obj.children)
+                while stack:
+                    current = stack.pop()
+                    if current.type == 'MESH':
+                        return True
+                    stack.extend(current.children)
+                continue
+            tops = self.coll_to_tops.get(coll.as_pointer())
+            if tops:
+                for top in tops:
+                    if self.top_has_mesh.get(top.as_pointer(), False):
+                        return True
+        return False
+
+
+cdef class HierarchyIndex:
+    """Per-root tree indices, shared by selection aggregation and operator polls."""
+
+    cdef dict _trees
+    cdef bint _tracking
+    cdef Py_ssize_t _collection_count
+    cdef Py_ssize_t _object_count
+    # Bumped whenever cached qualification results may have changed
+    cdef Py_ssize_t _generation
+    # Bumped on every scene update, which is how selection changes arrive
+    cdef Py_ssize_t _selection_generation
+    # root pointer -> (generation, selection generation, selection size, result)
+    cdef dict _any_cache
+
+    def __init__(self) -> None:
+        self._trees = {}
+        self._tracking = False
+        self._collection_count = -1
+        self._object_count = -1
+        self._generation = 0
+        self._selection_generation = 0
+        self._any_cache = {}
+
+    cpdef void set_tracking(self, bint value):
+        """Enable caching across calls; requires consume_depsgraph() on every update."""
+        self._tracking = value
+        self.invalidate()
+
+    cpdef void invalidate(self):
+        """Drop every tree (undo, redo, file load, collection edits)."""
+        self._trees.clear()
+        self._any_cache.clear()
+        self._collection_count = -1
+        self._object_count = -1
+        self._generation += 1
+
+    cpdef void invalidate_roots(self):
+        """Drop cached root lists and qualification results (objects were reparented)."""
+        cdef _TreeIndex tree
+        for tree in self._trees.values():
+            tree.roots.clear()
+            tree.qualified.clear()
+        self._generation += 1
+
+    cpdef Py_ssize_t get_generation(self):
+        return self._generation
+
+    cpdef void consume_depsgraph(self, object depsgraph):
+        """Invalidate whatever the update could have changed; O(updated IDs)."""
+        cdef _TreeIndex tree
+        cdef object key
+        cdef object parent_key
+        cdef object recorded
+        cdef bint reparented = False
+        for update in depsgraph.updates:
+            id_data = update.id.original
+            if isinstance(id_data, bpy.types.Collection):
+                self.invalidate()
+                return
+            if isinstance(id_data, bpy.types.Scene):
+                self._selection_generation += 1
+                # Links into the master collection only tag the scene
+                tree = self._trees.get(id_data.collection.as_pointer())
+                if tree is not None and (tree.root_object_count != len(tree.root.objects)
+                                         or tree.root_child_count != len(tree.root.children)):
+                    del self._trees[id_data.collection.as_pointer()]
+                    self._generation += 1
+                continue
+            if not self._trees:
+                continue
+            if not isinstance(id_data, bpy.types.Object):
+                continue
+            key = id_data.as_pointer()
+            parent_key = id_data.parent.as_pointer() if id_data.parent is not None else 0
+            for tree in self._trees.values():
+                recorded = tree.parents.get(key)
+                if recorded is not None and recorded != parent_key:
+                    tree.parents[key] = parent_key
+                    reparented = True
+        if reparented:
+            self.invalidate_roots()
+
+    cdef _TreeIndex _tree(self, object root):
+        cdef Py_ssize_t collection_count = len(bpy.data.collections)
+        cdef Py_ssize_t object_count = len(bpy.data.objects)
+        cdef object key = root.as_pointer()
+        cdef _TreeIndex tree
+        if (not self._tracking or collection_count != self._collection_count
+                or object_count != self._object_count):
+            self._trees.clear()
+            self._collection_count = collection_count
+            self._object_count = object_count
+            self._generation += 1
+        tree = self._trees.get(key)
+        if tree is None:
+            tree = _TreeIndex(root)
+            self._trees[key] = tree
+        return tree
+
+    # ==================== Queries ====================
+
+    cpdef list get_object_collections(self, object obj, object root):
+        """Collections under root (including root) that link obj; replaces users_collection."""
+        cdef list colls = self._tree(root).object_colls.get(obj.as_pointer())
+        return list(colls) if colls is not None else []
+
+    cpdef list get_tops(self, object coll, object root):
+        """Top-level collections under root that own coll (empty if none qualify)."""
+        cdef list tops = self._tree(root).coll_to_tops.get(coll.as_pointer())
+        return list(tops) if tops is not None else []
+
+    cpdef bint top_has_mesh(self, object top, object root):
+        return self._tree(root).top_has_mesh.get(top.as_pointer(), False)
+
+    cpdef list get_root_objects(self, object coll, object root):
+        """Parentless objects in coll's subtree, cached until something is reparented."""
+        cdef _TreeIndex tree = self._tree(root)
+        cdef object key = coll.as_pointer()
+        cdef list roots = tree.roots.get(key)
+        cdef list stack
+        cdef object current
+        if roots is None:
+            roots = []
+            stack = [coll]
+            while stack:
+                current = stack.pop()
+                for obj in current.objects:
+                    if obj.parent is None:
+                        roots.append(obj)
+                stack.extend(current.children)
+            tree.roots[key] = roots
+        return list(roots)
+
+    cpdef bint object_qualifies(self, object obj, object root):
+        """True if obj is a mesh (or has mesh children) in root, or sits in a top that holds meshes."""
+        return self._tree(root).qualifies(obj)
+
+    cpdef bint any_qualifies(self, object objects, object root):
+        """Poll helper for the current selection: True if any of objects qualifies.
+
+        While tracking, the answer is reused until the hierarchy or the
+        selection changes, so repeated polls on redraw cost O(1).
+        """
+        cdef _TreeIndex tree = self._tree(root)
+        cdef object key = root.as_pointer()
+        cdef Py_ssize_t count = len(objects)
+        cdef tuple cached = self._any_cache.get(key)
+        cdef bint result = False
+        if (self._tracking and cached is not None and cached[0] == self._generation
+                and cached[1] == self._selection_generation and cached[2] == count):
+            return cached[3]
+        for obj in objects:
+            if obj is not None and tree.qualifies(obj):
+                result = True
+                break
+        if self._tracking:
+            self._any_cache[key] = (self._generation, self._selection_generation, count, result)
+        return result
+
+    cpdef list qualifying_objects(self, object objects, object root):
+        """Unique qualifying objects, in selection order."""
+        cdef _TreeIndex tree = self._tree(root)
+        cdef list result = []
+        cdef set seen = set()
+        cdef object key
+        for obj in objects:
+            if obj is None:
+                continue
+            key = obj.as_pointer()
+            if key not in seen and tree.qualifies(obj):
+                seen.add(key)
+                result.append(obj)
+        return result
+
+
+# Global instance
+cdef HierarchyIndex _hierarchy_index = HierarchyIndex()
+
+cpdef HierarchyIndex get_hierarchy_index():
+    """Get the global hierarchy index instance."""
+    return _hierarchy_index
@@ -0,0 +1,279 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Pipeline instrumentation.
+
+Scoped stage timers and counters for the standardize/organize pipeline.
+A *call* is one top-level operation (e.g. ``standardize_groups``); stages and
+counters recorded while it is active are attached to it. Stage timings are
+inclusive and may nest (depsgraph evaluation happens inside selection).
+
+Modal operators spread one call over many event handler slices and may be
+dropped by Blender between two of them; they use a DetachedCall, which is
+current only while a slice runs.
+"""
+
+from collections import deque
+from time import perf_counter
+
+# Stage names shared by every instrumented module
+STAGE_SELECTION = "selection"
+STAGE_DEPSGRAPH = "depsgraph_eval"
+STAGE_SHM_FILL = "shm_fill"
+STAGE_ENGINE = "engine_compute"
+STAGE_JSON = "json_decode"
+STAGE_APPLY = "transform_apply"
+STAGE_ORGANIZE = "collection_organize"
+
+# Counter names
+COUNT_GROUPS = "groups"
+COUNT_OBJECTS = "objects"
+COUNT_VERTS = "verts"
+COUNT_EDGES = "edges"
+COUNT_BYTES = "bytes_sent"
+COUNT_SHARED_INSTANCES = "shared_instances"
+
+# Number of completed calls kept for inspection
+cdef int _HISTORY_LENGTH = 32
+
+cdef bint _enabled = True
+cdef object _history = deque(maxlen=_HISTORY_LENGTH)
+cdef dict _stage_totals = {}
+cdef object _current = None
+cdef int _depth = 0
+
+
+cdef class CallRecord:
+    """Timings and counters for one top-level operation."""
+
+    cdef public str name
+    cdef public double started
+    cdef public double elapsed
+    cdef public dict stages
+    cdef public dict counters
+
+    def __init__(self, str name) -> None:
+        self.name = name
+        self.started = perf_counter()
+        self.elapsed = 0.0
+        self.stages = {}
+        self.counters = {}
+
+    def as_dict(self) -> dict:
+        return {
+            "name": self.name,
+            "elapsed": self.elapsed,
+            "stages": dict(self.stages),
+            "counters": dict(self.counters),
+        }
+
+
+cdef class StageTimer:
+    """Context manager recording the wall time of one stage."""
+
+    cdef str _name
+    cdef double _start
+
+    def __init__(self, str name) -> None:
+        self._name = name
+        self._start = 0.0
+
+    def __enter__(self):
+        self._start = perf_counter()
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        if _enabled:
+            _record_stage(self._name, perf_counter() - self._start)
+        return False
+
+
+cdef class CallScope:
+    """Context manager delimiting a top-level call; nested scopes fold into the outer one."""
+
+    cdef str _name
+
+    def __init__(self, str name) -> None:
+        self._name = name
+
+    def __enter__(self):
+        begin_call(self._name)
+        return self
+
+    def __exit__(self, exc_type, exc, tb):
+        end_call()
+        return False
+
+
+cdef class DetachedCall:
+    """A top-level call spread over several main-thread slices (modal operators).
+
+    Its record is only current between resume() and suspend(), so the global
+    call depth is back to zero after every slice even if the owner disappears
+    before finish() (file load or a closed window drops modal handlers).
+    """
+
+    cdef CallRecord _record
+    cdef bint _resumed
+
+    def __init__(self, str name) -> None:
+        self._record = CallRecord(name) if _enabled else None
+        self._resumed = False
+
+    def resume(self) -> None:
+        """Make this call current for one slice, unless another call is active."""
+        global _current, _depth
+        if self._resumed or _depth != 0:
+            return
+        _current = self._record
+        _depth = 1
+        self._resumed = True
+
+    def suspend(self) -> None:
+        global _current, _depth
+        if not self._resumed:
+            return
+        self._resumed = False
+        if _current is self._record:
+            _current = None
+            _depth = 0
+
+    def finish(self) -> None:
+        """Push the call onto the history; later slices are no longer recorded."""
+        self.suspend()
+        if self._record is not None:
+            self._record.elapsed = perf_counter() - self._record.started
+            _history.append(self._record)
+            self._record = None
+
+
+cdef void _record_stage(str name, double seconds):
+    totals = _stage_totals.get(name)
+    if totals is None:
+        _stage_totals[name] = [1, seconds]
+    else:
+        totals[0] += 1
+        totals[1] += seconds
+    if _current is not None:
+        (<CallRecord>_current).stages[name] = (<CallRecord>_current).stages.get(name, 0.0) + seconds
+
+
+# ---------------------------------------------------------------------------
+# Recording API
+# ---------------------------------------------------------------------------
+
+def set_enabled(bint value) -> None:
+    """Enable or disable recording (timers still run their body)."""
+    global _enabled
+    _enabled = value
+
+
+def is_enabled() -> bool:
+    return _enabled
+
+
+def begin_call(str name) -> None:
+    """Start a top-level call unless one is already active."""
+    global _current, _depth
+    _depth += 1
+    if _depth == 1 and _enabled:
+        _current = CallRecord(name)
+
+
+def end_call() -> None:
+    """Finish the active call and push it onto the history."""
+    global _current, _depth
+    if _depth == 0:
+        return
+    _depth -= 1
+    if _depth == 0 and _current is not None:
+        (<CallRecord>_current).elapsed = perf_counter() - (<CallRecord>_current).started
+        _history.append(_current)
+        _current = None
+
+
+def call(str name) -> CallScope:
+    """Return a context manager for a top-level call."""
+    return CallScope(name)
+
+
+def detached_call(str name) -> DetachedCall:
+    """Return a call that is resumed and suspended around each modal slice."""
+    return DetachedCall(name)
+
+
+def instrumented(str name):
+    """Decorator form of call()."""
+    def decorate(func):
+        def wrapper(*args, **kwargs):
+            begin_call(name)
+            try:
+                return func(*args, **kwargs)
+            finally:
+                end_call()
+        wrapper.__name__ = func.__name__
+        wrapper.__doc__ = func.__doc__
+        return wrapper
+    return decorate
+
+
+def stage(str name) -> StageTimer:
+    """Return a context manager timing one stage of the active call."""
+    return StageTimer(name)
+
+
+def add_stage_time(str name, double seconds) -> None:
+    """Record a stage measured elsewhere (e.g. an engine call on a worker thread)."""
+    if _enabled:
+        _record_stage(name, seconds)
+
+
+def add_count(str name, value) -> None:
+    """Add value to a counter of the active call."""
+    if _enabled and _current is not None:
+        counters = (<CallRecord>_current).counters
+        counters[name] = counters.get(name, 0) + value
+
+
+# ---------------------------------------------------------------------------
+# Query API
+# ---------------------------------------------------------------------------
+
+def get_last_call():
+    """Return the most recent completed call as a dict, or None."""
+    if not _history:
+        return None
+    return (<CallRecord>_history[-1]).as_dict()
+
+
+def get_history() -> list:
+    """Return completed calls, oldest first."""
+    return [(<CallRecord>record).as_dict() for record in _history]
+
+
+def get_stage_totals() -> dict:
+    """Return stage name -> (count, total seconds) across the session."""
+    return {name: (totals[0], totals[1]) for name, totals in _stage_totals.items()}
+
+
+def reset() -> None:
+    """Forget all recorded calls and totals."""
+    global _current, _depth
+    _history.clear()
+    _stage_totals.clear()
+    _current = None
+    _depth = 0
@@ -0,0 +1,271 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Incremental shelf layout for organizing groups.
+
+Each surface class gets a band along +X; inside a band groups are packed
+first-fit onto shelves (rows) by their XY footprint. Placements are remembered
+between calls, so re-arranging only moves groups that are new, grew out of
+their slot or changed surface class. Slots of removed groups are returned to
+their shelf and reused.
+
+A band keeps its width until a group wider than the band arrives; the band is
+then widened (its shelves gain the extra width as a free gap) and every band
+after it shifts along +X, so no shelf ever reaches into a neighbouring band.
+"""
+
+import bpy
+import numpy as np
+cimport numpy as cnp
+from libc.math cimport sqrt
+
+# Spacing added around every footprint and between bands (scene units)
+cdef double _ITEM_MARGIN = 0.25
+cdef double _BAND_GAP = 2.0
+# Gaps narrower than this are dropped instead of kept on the shelf
+cdef double _MIN_GAP = 1e-6
+
+# Footprint columns: min x, min y, max x, max y, min z relative to the group's root
+FOOTPRINT_COLUMNS = 5
+
+
+cdef class _Shelf:
+    cdef double y
+    cdef double height
+    # Free [x, width] intervals, sorted by x
+    cdef list gaps
+
+    def __init__(self, double y, double height, double width) -> None:
+        self.y = y
+        self.height = height
+        self.gaps = [[0.0, width]]
+
+    cdef double take(self, double width):
+        """Reserve width in the first gap that fits; returns its x or -1."""
+        cdef list gap
+        cdef double x
+        for gap in self.gaps:
+            if gap[1] >= width:
+                x = gap[0]
+                gap[0] += width
+                gap[1] -= width
+                if gap[1] < _MIN_GAP:
+                    self.gaps.remove(gap)
+                return x
+        return -1.0
+
+    cdef void give_back(self, double x, double width):
+        cdef list merged = []
+        cdef list gap
+        self.gaps.append([x, width])
+        self.gaps.sort()
+        for gap in self.gaps:
+            if merged and merged[-1][0] + merged[-1][1] >= gap[0] - _MIN_GAP:
+                merged[-1][1] = max(merged[-1][0] + merged[-1][1], gap[0] + gap[1]) - merged[-1][0]
+            else:
+                merged.append(gap)
+        self.gaps = merged
+
+
+cdef class _Band:
+    cdef double x0
+    cdef double width
+    cdef double top
+    cdef list shelves
+
+    def __init__(self, double x0, double width) -> None:
+        self.x0 = x0
+        self.width = width
+        self.top = 0.0
+        self.shelves = []
+
+
+cdef class _Slot:
+    cdef object surface_key
+    cdef _Shelf shelf
+    cdef double x
+    cdef double width
+
+    def __init__(self, surface_key, _Shelf shelf, double x, double width) -> None:
+        self.surface_key = surface_key
+        self.shelf = shelf
+        self.x = x
+        self.width = width
+
+
+cdef class ShelfLayout:
+    """Remembers where each group was placed so later calls only move what changed."""
+
+    cdef dict _bands
+    cdef dict _slots
+    cdef double _next_band_x
+
+    def __init__(self) -> None:
+        self.reset()
+
+    def reset(self) -> None:
+        """Forget every placement (file load, classification reset)."""
+        self._bands = {}
+        self._slots = {}
+        self._next_band_x = 0.0
+
+    def __len__(self) -> int:
+        return len(self._slots)
+
+    cdef void _release(self, str name):
+        cdef _Slot slot = self._slots.pop(name, None)
+        if slot is not None:
+            slot.shelf.give_back(slot.x, slot.width)
+
+    cdef void _grow(self, _Band band, double width):
+        """Widen band to width and shift the bands placed after it."""
+        cdef double delta = width - band.width
+        cdef _Shelf shelf
+        cdef _Band other
+        for shelf in band.shelves:
+            shelf.give_back(band.width, delta)
+        for other in self._bands.values():
+            if other.x0 > band.x0:
+                other.x0 += delta
+        band.width = width
+        self._next_band_x += delta
+
+    cdef _Band _band_for(self, object surface_key, double min_width, double area):
+        cdef _Band band = self._bands.get(surface_key)
+        cdef double width
+        if band is None:
+            # Roughly square for the first batch; later batches only widen it
+            # when a group would not fit
+            width = max(min_width, sqrt(area))
+            band = _Band(self._next_band_x, width)
+            self._bands[surface_key] = band
+            self._next_band_x += width + _BAND_GAP
+        elif band.width < min_width:
+            self._grow(band, min_width)
+        return band
+
+    cdef _Slot _place(self, object surface_key, _Band band, double width, double depth):
+        cdef _Shelf shelf
+        cdef double x
+        for shelf in band.shelves:
+            if shelf.height >= depth:
+                x = shelf.take(width)
+                if x >= 0.0:
+                    return _Slot(surface_key, shelf, x, width)
+        # _band_for widened the band for this batch, so a new shelf always fits
+        shelf = _Shelf(band.top, depth, band.width)
+        band.top += depth
+        band.shelves.append(shelf)
+        return _Slot(surface_key, shelf, shelf.take(width), width)
+
+    def arrange(self, list group_names, const double[:, ::1] footprints, list surface_keys) -> cnp.ndarray:
+        """Return (N, 3) root positions aligned with group_names.
+
+        footprints holds FOOTPRINT_COLUMNS values per group, relative to the
+        group's root location. Groups missing from group_names release their slots.
+        """
+        cdef Py_ssize_t count = len(group_names)
+        cdef cnp.ndarray positions = np.zeros((count, 3), dtype=np.float64)
+        cdef double[:, ::1] pos_mv = positions
+        cdef cnp.ndarray widths = np.empty(count, dtype=np.float64)
+        cdef cnp.ndarray depths = np.empty(count, dtype=np.float64)
+        cdef double[::1] w_mv = widths
+        cdef double[::1] d_mv = depths
+        cdef list pending = []
+        cdef dict pending_area = {}
+        cdef dict pending_width = {}
+        cdef set submitted = set(group_names)
+        cdef Py_ssize_t i
+        cdef str name
+        cdef _Slot slot
+        cdef _Band band
+
+        for name in [n for n in self._slots if n not in submitted]:
+            self._release(name)
+
+        for i in range(count):
+            name = group_names[i]
+            w_mv[i] = footprints[i, 2] - footprints[i, 0] + _ITEM_MARGIN
+            d_mv[i] = footprints[i, 3] - footprints[i, 1] + _ITEM_MARGIN
+            slot = self._slots.get(name)
+            if slot is not None:
+                if slot.surface_key == surface_keys[i] and w_mv[i] <= slot.width and d_mv[i] <= slot.shelf.height:
+                    continue
+                self._release(name)
+            pending.append(i)
+            key = surface_keys[i]
+            pending_area[key] = pending_area.get(key, 0.0) + w_mv[i] * d_mv[i]
+            pending_width[key] = max(pending_width.get(key, 0.0), w_mv[i])
+
+        # Deepest first gives shelves of similar heights
+        pending.sort(key=lambda j: -depths[j])
+        for i in pending:
+            key = surface_keys[i]
+            band = self._band_for(key, pending_width[key], pending_area[key])
+            self._slots[group_names[i]] = self._place(key, band, w_mv[i], d_mv[i])
+
+        for i in range(count):
+            slot = self._slots[group_names[i]]
+            band = self._bands[slot.surface_key]
+            # Put the footprint's min corner (plus half the margin) at the slot corner
+            pos_mv[i, 0] = band.x0 + slot.x + _ITEM_MARGIN * 0.5 - footprints[i, 0]
+            pos_mv[i, 1] = slot.shelf.y + _ITEM_MARGIN * 0.5 - footprints[i, 1]
+            pos_mv[i, 2] = -footprints[i, 4]
+        return positions
+
+
+def compute_group_footprints(list group_names):
+    """Return (names, footprints, roots) for groups that have root objects.
+
+    footprints is (N, FOOTPRINT_COLUMNS) float64 of world-space bounds relative
+    to the first root's location; roots lists each group's parentless objects.
+    """
+    cdef list names = []
+    cdef list roots = []
+    cdef list rows = []
+    collections = bpy.data.collections
+    for name in group_names:
+        coll = collections.get(name)
+        if coll is None:
+            continue
+        objects = coll.objects
+        group_roots = [obj for obj in objects if obj.parent is None]
+        if not group_roots:
+            continue
+        ref = np.array(group_roots[0].matrix_world.translation, dtype=np.float64)
+        lo = np.full(3, np.inf)
+        hi = np.full(3, -np.inf)
+        for obj in objects:
+            matrix = np.array(obj.matrix_world, dtype=np.float64)
+            corners = np.array(obj.bound_box, dtype=np.float64) @ matrix[:3, :3].T + matrix[:3, 3]
+            lo = np.minimum(lo, corners.min(axis=0))
+            hi = np.maximum(hi, corners.max(axis=0))
+        lo -= ref
+        hi -= ref
+        names.append(name)
+        roots.append(group_roots)
+        rows.append((lo[0], lo[1], hi[0], hi[1], lo[2]))
+    footprints = np.ascontiguousarray(np.array(rows, dtype=np.float64).reshape(len(rows), FOOTPRINT_COLUMNS))
+    return names, footprints, roots
+
+
+# Global instance
+cdef ShelfLayout _shelf_layout = ShelfLayout()
+
+cpdef ShelfLayout get_shelf_layout():
+    """Get the global shelf layout instance."""
+    return _shelf_layout
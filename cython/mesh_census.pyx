@@ -0,0 +1,119 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Per-operation mesh census.
+
+A MeshCensus evaluates each object against the depsgraph at most once and
+caches what the standardize pipeline needs from it: the evaluated mesh and
+its vertex/edge counts. Selection aggregation, pivot setup and the SHM fill
+all read from the same census instead of calling ``evaluated_get``
+independently.
+"""
+
+import bpy
+from libc.stdint cimport uint32_t, uint64_t
+
+
+cdef class MeshCensusEntry:
+    """Cached evaluation data for a single object."""
+
+    cdef public object obj
+    cdef public object eval_mesh
+    cdef public uint32_t vert_count
+    cdef public uint32_t edge_count
+
+    def __init__(self, object obj) -> None:
+        self.obj = obj
+        self.eval_mesh = None
+        self.vert_count = 0
+        self.edge_count = 0
+
+
+cdef class MeshCensus:
+    """Evaluate-once cache of mesh objects shared by every pipeline stage."""
+
+    cdef object _depsgraph
+    cdef dict _entries
+
+    def __init__(self, object depsgraph=None) -> None:
+        self._depsgraph = depsgraph if depsgraph is not None else bpy.context.evaluated_depsgraph_get()
+        self._entries = {}
+
+    @property
+    def depsgraph(self):
+        return self._depsgraph
+
+    cpdef MeshCensusEntry entry(self, object obj):
+        """Return the cached entry for a mesh object, evaluating it on first use."""
+        cdef uint64_t key = obj.as_pointer()
+        cdef MeshCensusEntry cached = self._entries.get(key)
+        if cached is None:
+            cached = MeshCensusEntry(obj)
+            self._evaluate(cached)
+            self._entries[key] = cached
+        elif cached.eval_mesh is None:
+            self._evaluate(cached)
+        return cached
+
+    cdef void _evaluate(self, MeshCensusEntry cached):
+        eval_mesh = cached.obj.evaluated_get(self._depsgraph).data
+        cached.eval_mesh = eval_mesh
+        cached.vert_count = len(eval_mesh.vertices)
+        cached.edge_count = len(eval_mesh.edges)
+
+    cpdef object eval_mesh(self, object obj):
+        return self.entry(obj).eval_mesh
+
+    cpdef uint32_t vert_count(self, object obj):
+        if obj.type != 'MESH':
+            return 0
+        return self.entry(obj).vert_count
+
+    cpdef uint32_t edge_count(self, object obj):
+        if obj.type != 'MESH':
+            return 0
+        return self.entry(obj).edge_count
+
+    cpdef bint has_vertices(self, object obj):
+        """Return True if obj is a mesh whose evaluated data has vertices."""
+        return obj.type == 'MESH' and self.entry(obj).vert_count > 0
+
+    cpdef tuple totals(self, list objects):
+        """Return (total_verts, total_edges) across the given mesh objects."""
+        cdef uint64_t total_verts = 0
+        cdef uint64_t total_edges = 0
+        cdef MeshCensusEntry cached
+        for obj in objects:
+            cached = self.entry(obj)
+            total_verts += cached.vert_count
+            total_edges += cached.edge_count
+        return total_verts, total_edges
+
+    cpdef void rebind(self, object depsgraph):
+        """Point the census at a freshly evaluated depsgraph.
+
+        Edits made between stages (new collections, pivot parenting) cause
+        Blender to rebuild evaluated data, so mesh references captured earlier
+        may no longer be valid. They are re-captured (and recounted) lazily.
+        """
+        cdef MeshCensusEntry cached
+        self._depsgraph = depsgraph
+        for cached in self._entries.values():
+            cached.eval_mesh = None
+
+    def __len__(self) -> int:
+        return len(self._entries)
@@ -0,0 +1,87 @@
+// Copyright (C) 2025 Nicholas Wierzbowski / Elbo Studio
+// This file is part of the Pivot Bridge for Blender.
+
+// Parallel memcpy of a precomputed copy table, used by shm_utils to fill the
+// engine's verts/edges segments. Called with the GIL released; every job's
+// source and destination must stay valid for the duration of the call.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace pivot_bridge {
+
+struct CopyJob {
+    const void *src;
+    void *dst;
+    size_t bytes;
+};
+
+// Jobs larger than this are split so one huge mesh still spreads across threads
+constexpr size_t kCopyBlockBytes = 4u << 20;
+
+inline void copy_serial(const CopyJob *jobs, size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(jobs[i].dst, jobs[i].src, jobs[i].bytes);
+    }
+}
+
+// Run every job in the table; threads == 0 picks hardware_concurrency().
+// Falls back to a serial copy below min_parallel_bytes or if threads cannot be started.
+inline void parallel_copy(const CopyJob *jobs, size_t count, unsigned threads, size_t min_parallel_bytes) noexcept {
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += jobs[i].bytes;
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, (total + kCopyBlockBytes - 1) / kCopyBlockBytes));
+    if (threads <= 1 || total < min_parallel_bytes) {
+        copy_serial(jobs, count);
+        return;
+    }
+
+    try {
+        std::vector<CopyJob> blocks;
+        blocks.reserve(count + total / kCopyBlockBytes);
+        for (size_t i = 0; i < count; ++i) {
+            const char *src = static_cast<const char *>(jobs[i].src);
+            char *dst = static_cast<char *>(jobs[i].dst);
+            for (size_t done = 0; done < jobs[i].bytes; done += kCopyBlockBytes) {
+                blocks.push_back({src + done, dst + done, std::min(kCopyBlockBytes, jobs[i].bytes - done)});
+            }
+        }
+
+        std::atomic<size_t> next{0};
+        auto worker = [&blocks, &next]() noexcept {
+            for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < blocks.size();
+                 i = next.fetch_add(1, std::memory_order_relaxed)) {
+                std::memcpy(blocks[i].dst, blocks[i].src, blocks[i].bytes);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        try {
+            for (unsigned t = 1; t < threads; ++t) {
+                pool.emplace_back(worker);
+            }
+        } catch (...) {
+            // Fewer threads than asked for; the ones that started plus this one finish the table
+        }
+        worker();
+        for (std::thread &thread : pool) {
+            thread.join();
+        }
+    } catch (...) {
+        copy_serial(jobs, count);
+    }
+}
+
+} // namespace pivot_bridge
@@ -17,81 +17,88 @@
 
 # selection_utils.pyx - selection and grouping helpers for Blender objects
 
+include "edition_flags.pxi" # type: ignore this exists in a generated file
+
 import bpy
 from mathutils import Vector, Matrix, Quaternion
-from . import edition_utils
-from collections import defaultdict
-
-# Constants (must match pivot/surface_manager.py)
-CLASSIFICATION_MARKER_PROP = "pivot_is_classification_collection"
-CLASSIFICATION_ROOT_MARKER_PROP = "pivot_is_classification_root"
-
+from .mesh_census import MeshCensus
+from .hierarchy_index import get_hierarchy_index
+from . import instrumentation
+from .instrumentation import STAGE_DEPSGRAPH
 
 cpdef object get_root_object(object obj):
     while obj.parent is not None:
         obj = obj.parent
     return obj
 
-cpdef tuple get_mesh_and_all_descendants(object root, object depsgraph):
+cpdef tuple get_mesh_and_all_descendants(object root, object census):
     cdef list meshes = []
     cdef list descendants = [root]
     cdef list stack = [root]
     cdef object current
-    cdef object eval_obj
-    cdef object eval_mesh
     while stack:
         current = stack.pop()
-        if current.type == 'MESH':
-            eval_obj = current.evaluated_get(depsgraph)
-            eval_mesh = eval_obj.data
-            if len(eval_mesh.vertices) != 0:
-                meshes.append(current)
+        if census.has_vertices(current):
+            meshes.append(current)
         for child in current.children:
             descendants.append(child)
             stack.append(child)
     return meshes, descendants
 
 
-cpdef bint has_mesh_with_vertices(object root, object depsgraph):
+cpdef bint has_mesh_with_vertices(object root, object census):
     cdef list stack = [root]
     cdef object current
-    cdef object eval_obj
-    cdef object eval_mesh
     while stack:
         current = stack.pop()
-        if current.type == 'MESH':
-            eval_obj = current.evaluated_get(depsgraph)
-            eval_mesh = eval_obj.data
-            if len(eval_mesh.vertices) > 0:
-                return True
+        if census.has_vertices(current):
+            return True
         for child in current.children:
             stack.append(child)
     return False
 
 
-cpdef list get_all_root_objects(object coll):
-    cdef list roots = []
-    cdef object obj
-    for obj in coll.objects:
-        if obj.parent is None:
-            roots.append(obj)
-    for child in coll.children:
-        roots.extend(get_all_root_objects(child))
-    return roots
+def _aggregate_single_object(list selected_objects):
+    """Standard edition: the single selected object is its own group.
+
+    No collections are created and no pivots are set up, so only the counts
+    of that one object are taken.
+    """
+    if len(selected_objects) != 1:
+        raise ValueError("Standard edition only supports single object selection")
+
+    cdef object census = MeshCensus()
+    cdef object obj = selected_objects[0]
+    if not census.has_vertices(obj):
+        return [], [], [], 0, 0, 0, [], [], [], census
+
+    return (
+        [[obj]],  # mesh_groups
+        [[obj]],  # full_groups
+        [obj.name],  # group_names
+        census.vert_count(obj),
+        census.edge_count(obj),
+        1,
+        [],  # pivots (empty for standard edition single object)
+        [],
+        [],  # synced_pivots
+        census
+    )
 
 
 def aggregate_object_groups(list selected_objects):
-    """Group the selection by collection boundaries and root parents."""
+    """Group the selection by collection boundaries and root parents.
 
-    if edition_utils.is_standard_edition() and len(selected_objects) != 1:
-        raise ValueError("Standard edition only supports single object selection")
+    The returned MeshCensus holds the evaluated counts for every mesh in
+    mesh_groups and should be handed on to shm_utils.create_data_arrays.
+    """
+
+    IF PIVOT_EDITION_STANDARD:
+        return _aggregate_single_object(selected_objects)
 
-    cdef object depsgraph
+    cdef object census
     cdef object scene_coll
-    cdef object coll_to_top_map
-    cdef object top_coll
-    cdef object child_coll
-    cdef list stack
+    cdef object index
 
     cdef set root_objects
     cdef list mesh_groups
@@ -105,11 +112,12 @@ def aggregate_object_groups(list selected_objects):
     cdef object new_coll
     cdef object processed_coll
     cdef set collections_to_process
+    cdef list root_colls
     # Get the configured objects collection
     from pivot_lib import group_manager
     group_mgr = group_manager.get_group_manager()
     scene_coll = group_mgr.get_objects_collection()
-    depsgraph = bpy.context.evaluated_depsgraph_get()
+    census = MeshCensus()
     sync_state = group_mgr.get_sync_state()
     existing_groups = group_mgr.get_managed_group_names_set()
     cdef list synced_group_names = []
@@ -117,52 +125,8 @@ def aggregate_object_groups(list selected_objects):
     cdef list synced_parent_groups = []
     cdef list synced_parent_group_names = []
 
-    # Standard edition: just process the single selected object as-is
-    if edition_utils.is_standard_edition():
-        obj = selected_objects[0]
-        if obj.type != 'MESH':
-            return [], [], [], [], 0, 0, 0, []
-        
-        eval_obj = obj.evaluated_get(depsgraph)
-        eval_mesh = eval_obj.data
-        if len(eval_mesh.vertices) == 0:
-            return [], [], [], [], 0, 0, 0, []
-        
-        group_verts = len(eval_mesh.vertices)
-        group_edges = len(eval_mesh.edges)
-        
-        return (
-            [[obj]],  # mesh_groups
-            [[obj]],  # full_groups
-            [obj.name],  # group_names
-            group_verts,
-            group_edges,
-            1,
-            [],  # pivots (empty for standard edition single object)
-            [],
-            []  # synced_pivots
-        )
-
-    # Build a lookup that points every nested collection back to its top-level owner.
-    coll_to_top_map = defaultdict(list)
-    stack = []
-    for top_coll in scene_coll.children:
-        if top_coll.get(CLASSIFICATION_MARKER_PROP, False) or top_coll.get(CLASSIFICATION_ROOT_MARKER_PROP, False):
-            continue
-        invalid_found = False
-        temp_map = defaultdict(list)
-        stack = [(top_coll, top_coll)]
-        while stack:
-            current_coll, current_top = stack.pop()
-            if current_coll.get(CLASSIFICATION_MARKER_PROP, False) or current_coll.get(CLASSIFICATION_ROOT_MARKER_PROP, False):
-                invalid_found = True
-                continue
-            temp_map[current_coll].append(current_top)
-            for child_coll in current_coll.children:
-                stack.append((child_coll, current_top))
-        if not invalid_found:
-            for coll, tops in temp_map.items():
-                coll_to_top_map[coll].extend(tops)
+    # Top-level owners, object collections and group roots come from the shared index
+    index = get_hierarchy_index()
 
     root_objects = set()
     mesh_groups = []
@@ -184,29 +148,33 @@ def aggregate_object_groups(list selected_objects):
         root_obj = get_root_object(obj)
         root_objects.add(root_obj)
 
-    collections_to_process = set()
+    # Resolve every root's collections and owners before the loop below adds collections
+    root_colls = []
     for root_obj in root_objects:
-        if not has_mesh_with_vertices(root_obj, depsgraph):
+        if not has_mesh_with_vertices(root_obj, census):
             continue
-        for coll in root_obj.users_collection:
+        root_colls.append((root_obj, [(coll, index.get_tops(coll, scene_coll))
+                                      for coll in index.get_object_collections(root_obj, scene_coll)]))
+
+    collections_to_process = set()
+    for root_obj, colls in root_colls:
+        for coll, tops in colls:
             if coll == scene_coll:
                 new_coll = bpy.data.collections.new(root_obj.name)
                 scene_coll.objects.unlink(root_obj)
                 scene_coll.children.link(new_coll)
                 new_coll.objects.link(root_obj)
-                _, descendants = get_mesh_and_all_descendants(root_obj, depsgraph)
+                _, descendants = get_mesh_and_all_descendants(root_obj, census)
                 for obj in descendants:
                     if obj != root_obj and scene_coll in obj.users_collection:
                         scene_coll.objects.unlink(obj)
                         new_coll.objects.link(obj)
                 collections_to_process.add(new_coll)
-            elif coll in coll_to_top_map: 
-                for top in coll_to_top_map[coll]:
-                    # if not group_manager.get_group_manager().get_sync_state().get(top.name, False):
-                        collections_to_process.add(top)
+            else:
+                collections_to_process.update(tops)
 
     for processed_coll in collections_to_process:
-        top_roots = get_all_root_objects(processed_coll)
+        top_roots = index.get_root_objects(processed_coll, scene_coll)
         if not top_roots:
             continue
         if sync_state.get(processed_coll.name, False):
@@ -219,16 +187,10 @@ def aggregate_object_groups(list selected_objects):
         meshes = []
         descendants = []
         for root_obj in top_roots:
-            root_meshes, root_descendants = get_mesh_and_all_descendants(root_obj, depsgraph)
+            root_meshes, root_descendants = get_mesh_and_all_descendants(root_obj, census)
             meshes.extend(root_meshes)
             descendants.extend(root_descendants)
-        group_verts = 0
-        group_edges = 0
-        for m in meshes:
-            eval_obj = m.evaluated_get(depsgraph)
-            eval_mesh = eval_obj.data
-            group_verts += len(eval_mesh.vertices)
-            group_edges += len(eval_mesh.edges)
+        group_verts, group_edges = census.totals(meshes)
         mesh_groups.append(meshes)
         parent_groups.append(top_roots)
         full_groups.append(descendants)
@@ -249,7 +211,17 @@ def aggregate_object_groups(list selected_objects):
     else:
         synced_pivots = []
 
-    return mesh_groups, full_groups, group_names, total_verts, total_edges, total_objects, pivots, synced_group_names, synced_pivots
+    # Pivot setup reparents group roots
+    if pivots or synced_pivots:
+        index.invalidate_roots()
+
+    # Pivot setup and collection moves edit the scene; re-evaluate once so the
+    # census hands valid meshes and world matrices to the SHM fill.
+    if pivots or synced_pivots or collections_to_process:
+        with instrumentation.stage(STAGE_DEPSGRAPH):
+            census.rebind(bpy.context.evaluated_depsgraph_get())
+
+    return mesh_groups, full_groups, group_names, total_verts, total_edges, total_objects, pivots, synced_group_names, synced_pivots, census
 
 
 def _setup_pivots_for_groups_return_empties(parent_groups, group_names, existing_groups):
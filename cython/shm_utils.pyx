@@ -19,36 +19,449 @@ import numpy as np
 cimport numpy as cnp
 import elbo_sdk_rust as engine
 import json
+import zlib
 import bpy
-from mathutils import Matrix, Vector
-from libc.stdint cimport uint32_t
+from . import engine_state
+from . import instrumentation
+from .instrumentation import STAGE_SHM_FILL, STAGE_ENGINE, STAGE_JSON
+from .mesh_census import MeshCensus
+from .transform_utils import gather_world_matrices, pack_relative_transforms
+from libc.stdint cimport uint32_t, uint64_t, uintptr_t
 from libc.stddef cimport size_t
+from libc.string cimport memcpy
+from libcpp.vector cimport vector
+
+
+cdef extern from "parallel_copy.h" namespace "pivot_bridge" nogil:
+    cdef struct CopyJob:
+        const void* src
+        void* dst
+        size_t bytes
+    void parallel_copy(const CopyJob* jobs, size_t count, unsigned threads, size_t min_parallel_bytes)
+
+# Minimum capacity and growth factor for staging buffers. Growing geometrically
+# keeps steady-state standardize calls from allocating once the largest
+# selection of the session has been seen.
+cdef size_t _ARENA_MIN_BYTES = 64 * 1024
+cdef double _ARENA_GROWTH = 1.5
+
+
+cdef class StagingArena:
+    """Session-lifetime pool of growable, named scratch buffers.
+
+    This only reuses bridge-side scratch. The engine SHM segments (verts,
+    edges, rotations, scales, offsets) are still allocated fresh by the SDK on
+    every prepare_standardize_* call and released by finalize(); the SDK takes
+    no caller-owned segments, so those mmaps and first-touch faults remain.
+
+    Everything the bridge stages on its own side of the copy that is large
+    enough to matter (world and pivot matrix batches, fingerprint hashing
+    scratch, sampling source positions) comes from here so repeated calls
+    reuse the same pages. Per-object counts go to the SDK as Python lists and
+    are built as lists.
+    """
+
+    cdef dict _buffers
+
+    def __init__(self) -> None:
+        self._buffers = {}
+
+    cpdef cnp.ndarray reserve(self, str name, object dtype, size_t count):
+        """Return a view of at least count elements of dtype backed by the named buffer.
+
+        Contents are undefined; views returned earlier for the same name are
+        invalidated when the buffer has to grow.
+        """
+        cdef size_t itemsize = np.dtype(dtype).itemsize
+        cdef size_t nbytes = count * itemsize
+        cdef size_t capacity
+        cdef cnp.ndarray backing = self._buffers.get(name)
+        if backing is None or <size_t>backing.nbytes < nbytes:
+            capacity = _ARENA_MIN_BYTES
+            if backing is not None:
+                capacity = max(capacity, <size_t>(<double>backing.nbytes * _ARENA_GROWTH))
+            capacity = max(capacity, nbytes)
+            backing = np.empty(capacity, dtype=np.uint8)
+            self._buffers[name] = backing
+        return backing[:nbytes].view(dtype)
+
+    cpdef size_t bytes_reserved(self):
+        """Return the total capacity currently held by the arena."""
+        cdef size_t total = 0
+        cdef cnp.ndarray backing
+        for backing in self._buffers.values():
+            total += backing.nbytes
+        return total
+
+    cpdef void release(self):
+        """Drop every buffer so the memory can return to the OS."""
+        self._buffers.clear()
+
+
+cdef StagingArena _staging_arena = StagingArena()
+
+# Fixed-stride record for one standardize result, in submission order.
+STANDARDIZE_RESULT_DTYPE = np.dtype([
+    ("rot", np.float64, 4),      # w, x, y, z
+    ("origin", np.float64, 3),
+    ("cog", np.float64, 3),
+    ("surface_type", np.int32),  # -1 when the engine did not report one
+    ("valid", np.bool_),         # False when the engine returned no entry
+])
+
+cpdef StagingArena get_staging_arena():
+    """Get the global staging arena instance."""
+    return _staging_arena
+
+cpdef void release_staging_arena():
+    """Release all staging memory; called on file load and addon unregister."""
+    _staging_arena.release()
+
+
+cpdef tuple compute_mesh_fingerprint(object eval_mesh):
+    """Return (vert count, edge count, crc32 of co) for an evaluated mesh."""
+    cdef uint32_t vert_count = len(eval_mesh.vertices)
+    cdef uint32_t edge_count = len(eval_mesh.edges)
+    cdef cnp.ndarray scratch = _staging_arena.reserve("fingerprint", np.float32, vert_count * 3)
+    if vert_count > 0:
+        _copy_positions(eval_mesh, vert_count, scratch)
+    return (vert_count, edge_count, zlib.crc32(scratch))
+
+
+cpdef bint mesh_matches_fingerprint(object obj, object depsgraph):
+    """Return True if obj's evaluated mesh is identical to what was last uploaded.
+
+    Counts are compared first so topology changes never pay for the hash.
+    """
+    cdef tuple uploaded = engine_state.get_object_fingerprint(obj.as_pointer())
+    if uploaded is None:
+        return False
+    eval_mesh = obj.evaluated_get(depsgraph).data
+    if len(eval_mesh.vertices) != uploaded[0] or len(eval_mesh.edges) != uploaded[1]:
+        return False
+    return compute_mesh_fingerprint(eval_mesh) == uploaded
+
+
+cpdef cnp.ndarray unpack_standardize_results(dict results, list names):
+    """Decode name-keyed engine results into records aligned with names.
+
+    Downstream stages index the returned structured array (or its "rot",
+    "origin", "cog" field views) by position instead of looking up names.
+    """
+    cdef Py_ssize_t count = len(names)
+    cdef cnp.ndarray records = np.zeros(count, dtype=STANDARDIZE_RESULT_DTYPE)
+    cdef cnp.ndarray rot = records["rot"]
+    cdef cnp.ndarray origin = records["origin"]
+    cdef cnp.ndarray cog = records["cog"]
+    cdef cnp.ndarray surface_type = records["surface_type"]
+    cdef cnp.ndarray valid = records["valid"]
+    cdef Py_ssize_t i
+    cdef object entry
+    surface_type[:] = -1
+    for i in range(count):
+        entry = results.get(names[i])
+        if entry is None:
+            continue
+        rot[i] = entry["rot"]
+        origin[i] = entry["origin"]
+        cog[i] = entry["cog"]
+        if "surface_type" in entry:
+            surface_type[i] = int(entry["surface_type"])
+        valid[i] = True
+    return records
+
+
+# ---------------------------------------------------------------------------
+# Submission modes
+# ---------------------------------------------------------------------------
+
+# FULL sends every evaluated vertex and edge. POINTS drops the edges.
+# SAMPLED also drops the edges and caps each object at _sample_max_verts
+# vertices, picked one per cell of a uniform grid over the object's bounds
+# (plus the axis extremes, so bounds and contact surfaces are kept).
+SUBMIT_FULL = "FULL"
+SUBMIT_POINTS = "POINTS"
+SUBMIT_SAMPLED = "SAMPLED"
+
+cdef enum SubmissionMode:
+    _MODE_FULL = 0
+    _MODE_POINTS = 1
+    _MODE_SAMPLED = 2
+
+cdef uint32_t _sample_max_verts = 4096
+
+
+def set_sample_max_verts(uint32_t max_verts) -> None:
+    """Set the per-object vertex cap of the SAMPLED submission mode."""
+    global _sample_max_verts
+    _sample_max_verts = max(max_verts, 8)
+
+
+def get_sample_max_verts() -> int:
+    return _sample_max_verts
+
+
+cdef SubmissionMode _parse_submission_mode(str mode) except *:
+    if mode is None or mode == SUBMIT_FULL:
+        return _MODE_FULL
+    if mode == SUBMIT_POINTS:
+        return _MODE_POINTS
+    if mode == SUBMIT_SAMPLED:
+        return _MODE_SAMPLED
+    raise ValueError(f"Unknown submission mode: {mode}")
+
+
+cdef void _sample_vertices(cnp.ndarray full_co, uint32_t vert_count, uint32_t budget, cnp.ndarray out):
+    """Write exactly budget spatially stratified vertices of full_co (vert_count x 3) into out."""
+    points = full_co[:vert_count * 3].reshape(vert_count, 3)
+    lo = points.min(axis=0)
+    extent = points.max(axis=0) - lo
+    cdef int resolution = max(1, <int>np.ceil(np.cbrt(budget)))
+    scale = np.where(extent > 0, resolution / np.maximum(extent, 1e-30), 0.0).astype(np.float32)
+    cells = np.minimum(((points - lo) * scale).astype(np.int64), resolution - 1)
+    cell_ids = (cells[:, 0] * resolution + cells[:, 1]) * resolution + cells[:, 2]
+    _, cell_first = np.unique(cell_ids, return_index=True)
+
+    extremes = np.concatenate((points.argmin(axis=0), points.argmax(axis=0)))
+    extremes = extremes[np.sort(np.unique(extremes, return_index=True)[1])]
+    rest = np.setdiff1d(cell_first, extremes, assume_unique=False)
+    chosen = np.concatenate((extremes, rest))
+    if chosen.shape[0] > budget:
+        keep = np.linspace(0, rest.shape[0] - 1, budget - extremes.shape[0]).astype(np.int64)
+        chosen = np.concatenate((extremes, rest[keep]))
+    elif chosen.shape[0] < budget:
+        # Sparse grids: pad with evenly spaced vertices (duplicates do not move a hull)
+        pad = np.linspace(0, vert_count - 1, budget - chosen.shape[0]).astype(np.int64)
+        chosen = np.concatenate((chosen, pad))
+    np.take(points, chosen, axis=0, out=out.reshape(budget, 3))
+
+
+# Direct attribute copy: Blender stores "position" (float3) and ".edge_verts"
+# (int2) as contiguous arrays, so when the layer's element pointers confirm
+# that layout, one memcpy replaces foreach_get's per-element RNA walk.
+cdef bint _direct_copy_enabled = True
+
+
+def set_direct_copy_enabled(bint enabled) -> None:
+    """Enable or disable the memcpy path for positions and edges (foreach_get otherwise)."""
+    global _direct_copy_enabled
+    _direct_copy_enabled = enabled
+
+
+def get_direct_copy_enabled() -> bool:
+    return _direct_copy_enabled
+
+
+# Threads for the direct copy stage (0 = all cores) and the table size below
+# which spawning them costs more than it saves.
+cdef unsigned _fill_threads = 0
+cdef size_t _PARALLEL_FILL_MIN_BYTES = 16 * 1024 * 1024
+
+
+def set_fill_threads(unsigned threads) -> None:
+    """Set the thread count of the direct copy stage (0 = all cores, 1 = serial)."""
+    global _fill_threads
+    _fill_threads = threads
+
+
+def get_fill_threads() -> int:
+    return _fill_threads
 
-def create_data_arrays(uint32_t total_verts, uint32_t total_edges, uint32_t total_objects, list mesh_groups, list pivots, bint is_group_mode, list group_names, list surface_contexts):
-    depsgraph = bpy.context.evaluated_depsgraph_get()
-    verts_size = total_verts * 3 * 4  # float32 = 4 bytes
-    edges_size = total_edges * 2 * 4  # uint32 = 4 bytes
-    rotations_size = total_objects * 4 * 4  # float32 = 4 bytes
-    scales_size = total_objects * 3 * 4
-    offsets_size = total_objects * 3 * 4
 
+cdef uintptr_t _attribute_pointer(object mesh, str name, str data_type, str domain, uint32_t count, size_t stride):
+    """Return the address of a contiguous attribute layer of count elements, or 0 if the layout differs."""
+    cdef object attr
+    cdef object data
+    cdef uintptr_t first
+    if not _direct_copy_enabled or count == 0:
+        return 0
+    attr = mesh.attributes.get(name)
+    if attr is None or attr.data_type != data_type or attr.domain != domain:
+        return 0
+    data = attr.data
+    if len(data) != count:
+        return 0
+    first = <uintptr_t>data[0].as_pointer()
+    # Element pointers must step by exactly one element across the whole layer
+    if count > 1 and (<uintptr_t>data[1].as_pointer() != first + stride
+                      or <uintptr_t>data[count - 1].as_pointer() != first + (count - 1) * stride):
+        return 0
+    return first
+
+
+cdef inline uintptr_t _positions_pointer(object mesh, uint32_t count):
+    return _attribute_pointer(mesh, "position", "FLOAT_VECTOR", "POINT", count, 3 * sizeof(float))
+
+
+cdef inline uintptr_t _edges_pointer(object mesh, uint32_t count):
+    # Edge indices are non-negative, so int32 pairs have the engine's uint32 bit pattern
+    return _attribute_pointer(mesh, ".edge_verts", "INT32_2D", "EDGE", count, 2 * sizeof(int))
+
+
+cdef void _copy_positions(object mesh, uint32_t count, cnp.ndarray out):
+    """Copy count positions into the contiguous array out right away."""
+    cdef uintptr_t src = _positions_pointer(mesh, count)
+    if src != 0:
+        memcpy(cnp.PyArray_DATA(out), <const void*>src, count * 3 * sizeof(float))
+    else:
+        mesh.vertices.foreach_get("co", out)
+
+
+cdef inline void _queue_copy(vector[CopyJob]& jobs, uintptr_t src, cnp.ndarray out, size_t nbytes):
+    cdef CopyJob job
+    job.src = <const void*>src
+    job.dst = cnp.PyArray_DATA(out)
+    job.bytes = nbytes
+    jobs.push_back(job)
+
+
+# Vertex budget for one streamed upload chunk (96 MiB of float32 positions).
+# Groups are never split, so a chunk holding a single larger group may exceed it.
+cdef uint64_t _upload_chunk_verts = 8 * 1024 * 1024
+
+# Engine counts are 32-bit
+cdef uint64_t _ENGINE_MAX_COUNT = 0xFFFFFFFF
+
+
+def set_upload_chunk_verts(uint64_t max_verts) -> None:
+    """Set the vertex budget per upload chunk (0 uploads everything in one chunk)."""
+    global _upload_chunk_verts
+    _upload_chunk_verts = max_verts
+
+
+def get_upload_chunk_verts() -> int:
+    return _upload_chunk_verts
+
+
+cpdef list plan_upload_chunks(list mesh_groups, list group_names, object census):
+    """Split mesh_groups into contiguous (start, end) ranges within the vertex budget.
+
+    Each range becomes its own prepare/finalize command, which keeps every
+    command's counts within 32 bits and bounds the shared memory resident at once.
+    """
+    cdef list chunks = []
+    cdef Py_ssize_t count = len(mesh_groups)
+    cdef Py_ssize_t start = 0
+    cdef Py_ssize_t i
+    cdef uint64_t chunk_verts = 0
+    cdef uint64_t chunk_edges = 0
+    cdef uint64_t group_verts
+    cdef uint64_t group_edges
+    for i in range(count):
+        group_verts, group_edges = census.totals(mesh_groups[i])
+        if group_verts > _ENGINE_MAX_COUNT or group_edges > _ENGINE_MAX_COUNT:
+            raise RuntimeError(f"Group '{group_names[i]}' has too many vertices or edges for one engine command")
+        if i > start and (
+                (_upload_chunk_verts and chunk_verts + group_verts > _upload_chunk_verts)
+                or chunk_verts + group_verts > _ENGINE_MAX_COUNT
+                or chunk_edges + group_edges > _ENGINE_MAX_COUNT):
+            chunks.append((start, i))
+            start = i
+            chunk_verts = 0
+            chunk_edges = 0
+        chunk_verts += group_verts
+        chunk_edges += group_edges
+    if start < count:
+        chunks.append((start, count))
+    return chunks
+
+
+def create_data_arrays(list mesh_groups, list pivots, bint is_group_mode, list group_names, list surface_contexts, object census=None, str submission_mode=SUBMIT_FULL):
+    """Copy mesh groups into engine shared memory and run the standardize command.
+
+    census is the MeshCensus built during selection aggregation; its counts are
+    reused so each object is evaluated once. Transforms are gathered and packed
+    in one batch by transform_utils.
+    """
+    shm_context, fingerprints, group_bytes = fill_data_arrays(mesh_groups, pivots, is_group_mode, group_names, surface_contexts, census, submission_mode)
+
+    # Finalize the engine command and return parsed JSON so callers receive
+    # the final response instead of a raw shared-memory context.
+    with instrumentation.stage(STAGE_ENGINE):
+        final_json = shm_context.finalize()
+    return decode_standardize_response(final_json, fingerprints, group_bytes)
+
+
+def fill_data_arrays(list mesh_groups, list pivots, bint is_group_mode, list group_names, list surface_contexts, object census=None, str submission_mode=SUBMIT_FULL):
+    """Prepare the standardize command and fill its shared memory without finalizing it.
+
+    Returns (shm_context, fingerprints, group_bytes). The caller runs ``shm_context.finalize()``
+    (possibly on an engine_task worker) and passes the JSON it returns to
+    decode_standardize_response() on the main thread. submission_mode is one
+    of the SUBMIT_* constants.
+    """
+    cdef SubmissionMode mode = _parse_submission_mode(submission_mode)
+    if census is None:
+        census = MeshCensus()
+
+    with instrumentation.stage(STAGE_SHM_FILL):
+        return _fill_shm_context(mesh_groups, pivots, is_group_mode, group_names, surface_contexts, census, mode)
+
+
+def decode_standardize_response(object final_json, dict fingerprints, dict group_bytes=None):
+    """Parse a finalize() response; if it succeeded, record the per-group fingerprints and sent bytes."""
+    with instrumentation.stage(STAGE_JSON):
+        final_response = json.loads(final_json)
+    if final_response.get("ok", True):
+        if fingerprints:
+            engine_state.update_object_fingerprints(fingerprints)
+        if group_bytes:
+            engine_state.record_group_uploads(group_bytes)
+    return final_response
+
+
+cdef tuple _fill_shm_context(list mesh_groups, list pivots, bint is_group_mode, list group_names, list surface_contexts, object census, SubmissionMode mode):
+    """Prepare the engine command and copy counts, transforms and mesh data into its buffers.
+
+    Returns (shm_context, fingerprints, group_bytes). fingerprints maps group
+    name -> {Object.as_pointer(): fingerprint}, is only filled in group mode and
+    always describes the full evaluated mesh, whatever was sent. group_bytes
+    maps group name -> geometry bytes actually written (group mode only).
+    """
     # Build counts and object names without generators to avoid closures
+    cdef uint32_t total_objects = 0
+    cdef list group
+    cdef object obj
+    cdef object entry
+    for group in mesh_groups:
+        total_objects += len(group)
+
+    # The SDK takes the counts as Python lists, so they are built as lists directly
     cdef list vert_counts_list = []
     cdef list edge_counts_list = []
     cdef list object_counts_list = []
     cdef list object_names_list = []
-    cdef list group
-    cdef object obj
-    cdef object eval_obj
-    cdef object eval_mesh
+    cdef uint64_t total_verts = 0
+    cdef uint64_t total_edges = 0
+    cdef uint32_t sent_verts
+    cdef uint32_t sent_edges
+    cdef size_t obj_idx = 0
     for group in mesh_groups:
         object_counts_list.append(len(group))
         for obj in group:
-            eval_obj = obj.evaluated_get(depsgraph)
-            eval_mesh = eval_obj.data
+            entry = census.entry(obj)
             object_names_list.append(obj.name)
-            vert_counts_list.append(len(eval_mesh.vertices))
-            edge_counts_list.append(len(eval_mesh.edges))
+            sent_verts = entry.vert_count
+            sent_edges = entry.edge_count
+            if mode != _MODE_FULL:
+                sent_edges = 0
+                if mode == _MODE_SAMPLED and sent_verts > _sample_max_verts:
+                    sent_verts = _sample_max_verts
+            vert_counts_list.append(sent_verts)
+            edge_counts_list.append(sent_edges)
+            total_verts += sent_verts
+            total_edges += sent_edges
+
+    verts_size = total_verts * 3 * 4  # float32 = 4 bytes
+    edges_size = total_edges * 2 * 4  # uint32 = 4 bytes
+    rotations_size = total_objects * 4 * 4  # float32 = 4 bytes
+    scales_size = total_objects * 3 * 4
+    offsets_size = total_objects * 3 * 4
+
+    instrumentation.add_count(instrumentation.COUNT_OBJECTS, total_objects)
+    instrumentation.add_count(instrumentation.COUNT_VERTS, total_verts)
+    instrumentation.add_count(instrumentation.COUNT_EDGES, total_edges)
+    instrumentation.add_count(instrumentation.COUNT_BYTES, verts_size + edges_size + rotations_size + scales_size + offsets_size)
 
     # Prepare shared memory using the per-object counts and names so finalize needs no args
     if is_group_mode:
@@ -63,93 +476,90 @@ def create_data_arrays(uint32_t total_verts, uint32_t total_edges, uint32_t tota
     cdef cnp.ndarray scales = np.ndarray((scales_size // 4,), dtype=np.float32, buffer=scales_shm)
     cdef cnp.ndarray offsets = np.ndarray((offsets_size // 4,), dtype=np.float32, buffer=offsets_shm)
 
-    cdef size_t idx_rot = 0
-    cdef size_t idx_scale = 0
-    cdef size_t idx_offset = 0
-    cdef uint32_t curr_verts_offset = 0
-    cdef uint32_t curr_edges_offset = 0
-    cdef object quat
-    cdef object scale_vec
+    # Pack rotations/scales/offsets for the whole batch in one typed pass
+    cdef list flat_objects = []
+    for group in mesh_groups:
+        flat_objects.extend(group)
+    cdef cnp.ndarray object_counts = np.array(object_counts_list, dtype=np.uint32)
+    cdef cnp.ndarray world_mats = _staging_arena.reserve("world_matrices", np.float32, total_objects * 16).reshape(total_objects, 16)
+    gather_world_matrices(flat_objects, world_mats, _staging_arena)
+    cdef cnp.ndarray pivot_mats = _staging_arena.reserve("pivot_matrices", np.float32, len(pivots) * 16).reshape(len(pivots), 16)
+    if is_group_mode:
+        gather_world_matrices(pivots, pivot_mats, _staging_arena)
+    pack_relative_transforms(world_mats, pivot_mats, object_counts, is_group_mode, rotations, scales, offsets)
+
+    cdef uint64_t curr_verts_offset = 0
+    cdef uint64_t curr_edges_offset = 0
     cdef object mesh
-    cdef object pivot_obj
-    cdef object pivot_matrix_world
-    cdef object pivot_matrix_inv
-    cdef object obj_local_matrix
-    cdef object local_translation
-    cdef object trans_vec
     cdef uint32_t obj_vert_count
     cdef uint32_t obj_edge_count
-    cdef uint32_t vert_offset
-    cdef uint32_t edge_offset
-    cdef size_t group_idx = 0
-
-    for group in mesh_groups:
-        vert_offset = 0
-        edge_offset = 0
+    cdef uint32_t sent_vert_count
+    cdef uintptr_t src
+    # group name -> {Object.as_pointer(): fingerprint}, keyed like engine_state stores them
+    cdef dict fingerprints = {}
+    cdef dict group_fingerprints = None
+    cdef dict group_bytes = {}
+    cdef uint64_t sent_bytes
+    cdef Py_ssize_t group_idx
+    # Direct copies are only gathered here (attribute lookups need the GIL) and run together below
+    cdef vector[CopyJob] copy_jobs
+    cdef list pending_fingerprints = []
+
+    obj_idx = 0
+    for group_idx in range(len(mesh_groups)):
         if is_group_mode:
-            pivot_obj = pivots[group_idx]
-            pivot_matrix_world = pivot_obj.matrix_world.copy()
-            try:
-                pivot_matrix_inv = pivot_matrix_world.inverted()
-            except Exception:
-                pivot_matrix_inv = Matrix.Identity(4)
-            pivot_basis_inv = pivot_matrix_inv.to_3x3()
-            use_pivot_transform = True
-        else:
-            pivot_obj = None
-            pivot_matrix_inv = Matrix.Identity(4)
-            pivot_basis_inv = Matrix.Identity(3)
-            use_pivot_transform = False
-        for obj in group:
-            if use_pivot_transform:
-                obj_local_matrix = pivot_matrix_inv @ obj.matrix_world
-                quat = obj_local_matrix.to_3x3().to_quaternion()
-                trans_vec = obj.matrix_world.translation - pivot_obj.matrix_world.translation
-                local_translation = pivot_basis_inv @ trans_vec
-            else:
-                quat = obj.matrix_world.to_3x3().to_quaternion()
-                local_translation = Vector((0.0, 0.0, 0.0))
-            rotations[idx_rot] = quat.w
-            rotations[idx_rot + 1] = quat.x
-            rotations[idx_rot + 2] = quat.y
-            rotations[idx_rot + 3] = quat.z
-            idx_rot += 4
-
-            scale_vec = obj.matrix_world.to_3x3().to_scale()
-            scales[idx_scale] = scale_vec.x
-            scales[idx_scale + 1] = scale_vec.y
-            scales[idx_scale + 2] = scale_vec.z
-            idx_scale += 3
-
-            # Offset relative to the pivot coordinate system, accounting for child/parent hierarchy
-
-            offsets[idx_offset] = local_translation.x
-            offsets[idx_offset + 1] = local_translation.y
-            offsets[idx_offset + 2] = local_translation.z
-            idx_offset += 3
-
-            eval_obj = obj.evaluated_get(depsgraph)
-            mesh = eval_obj.data
-            obj_vert_count = len(mesh.vertices)
-            obj_edge_count = len(mesh.edges)
-
-            if obj_vert_count > 0:
-                mesh.vertices.foreach_get("co", all_verts[curr_verts_offset + vert_offset:curr_verts_offset + vert_offset + obj_vert_count * 3])
-                vert_offset += obj_vert_count * 3
-
-            if obj_edge_count > 0:
-                mesh.edges.foreach_get("vertices", all_edges[curr_edges_offset + edge_offset:curr_edges_offset + edge_offset + obj_edge_count * 2])
-                edge_offset += obj_edge_count * 2
-
-        curr_verts_offset += vert_offset
-        curr_edges_offset += edge_offset
-        group_idx += 1
+            group_fingerprints = fingerprints.setdefault(group_names[group_idx], {})
+        sent_bytes = 0
+        for obj in <list>mesh_groups[group_idx]:
+            entry = census.entry(obj)
+            mesh = entry.eval_mesh
+            obj_vert_count = entry.vert_count
+            obj_edge_count = entry.edge_count
+            sent_vert_count = vert_counts_list[obj_idx]
+            # float32 xyz per vertex, uint32 pair per edge
+            sent_bytes += <uint64_t>sent_vert_count * 12 + <uint64_t>edge_counts_list[obj_idx] * 8
+            obj_idx += 1
+
+            if sent_vert_count > 0:
+                verts_slice = all_verts[curr_verts_offset:curr_verts_offset + sent_vert_count * 3]
+                if sent_vert_count == obj_vert_count:
+                    src = _positions_pointer(mesh, obj_vert_count)
+                    if src != 0:
+                        _queue_copy(copy_jobs, src, verts_slice, obj_vert_count * 3 * sizeof(float))
+                    else:
+                        mesh.vertices.foreach_get("co", verts_slice)
+                    full_co = verts_slice
+                else:
+                    full_co = _staging_arena.reserve("sample_source", np.float32, obj_vert_count * 3)
+                    _copy_positions(mesh, obj_vert_count, full_co)
+                    _sample_vertices(full_co, obj_vert_count, sent_vert_count, verts_slice)
+                curr_verts_offset += sent_vert_count * 3
+                if is_group_mode:
+                    if full_co is verts_slice:
+                        # Hashed once the queued copy has landed
+                        pending_fingerprints.append((group_fingerprints, obj.as_pointer(), obj_vert_count, obj_edge_count, verts_slice))
+                    else:
+                        group_fingerprints[obj.as_pointer()] = (obj_vert_count, obj_edge_count, zlib.crc32(full_co))
+
+            if mode == _MODE_FULL and obj_edge_count > 0:
+                edges_slice = all_edges[curr_edges_offset:curr_edges_offset + obj_edge_count * 2]
+                src = _edges_pointer(mesh, obj_edge_count)
+                if src != 0:
+                    _queue_copy(copy_jobs, src, edges_slice, obj_edge_count * 2 * sizeof(uint32_t))
+                else:
+                    mesh.edges.foreach_get("vertices", edges_slice)
+                curr_edges_offset += obj_edge_count * 2
+        if is_group_mode:
+            group_bytes[group_names[group_idx]] = sent_bytes
 
-    # Finalize the engine command and return parsed JSON so callers receive
-    # the final response instead of a raw shared-memory context.
-    final_json = shm_context.finalize()
-    final_response = json.loads(final_json)
-    return final_response
+    if copy_jobs.size() > 0:
+        with nogil:
+            parallel_copy(copy_jobs.data(), copy_jobs.size(), _fill_threads, _PARALLEL_FILL_MIN_BYTES)
+
+    for entry in pending_fingerprints:
+        entry[0][entry[1]] = (entry[2], entry[3], zlib.crc32(entry[4]))
+
+    return shm_context, fingerprints, group_bytes
 
 
 # def prepare_face_data(uint32_t total_objects, list mesh_groups):
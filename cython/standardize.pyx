@@ -26,11 +26,20 @@ from mathutils import Quaternion, Vector, Matrix
 
 import bpy
 import json
+import numpy as np
 
-from . import selection_utils, shm_utils, edition_utils, group_manager
+include "edition_flags.pxi" # type: ignore this exists in a generated file
+
+from . import selection_utils, shm_utils, group_manager, transform_utils
+from . import engine_task
 from . import engine_state
+from .mesh_census import MeshCensus
+from . import instrumentation
+from .instrumentation import STAGE_SELECTION, STAGE_ENGINE, STAGE_JSON, STAGE_APPLY, STAGE_ORGANIZE, COUNT_GROUPS, COUNT_SHARED_INSTANCES
 import elbo_sdk_rust as engine
 from .surface_manager import get_surface_manager
+from .command_queue import get_command_queue
+from .change_tracker import get_change_tracker
 from multiprocessing.shared_memory import SharedMemory
 
 # Collection metadata keys
@@ -38,36 +47,50 @@ GROUP_COLLECTION_PROP = "pivot_group_name"
 CLASSIFICATION_ROOT_COLLECTION_NAME = "Pivot"
 CLASSIFICATION_COLLECTION_PROP = "pivot_surface_type"
 
-def _apply_transforms_to_pivots(pivots, origins, rots, cogs, bint origin_method_is_base):
-    """Apply position and rotation transforms to pivots using the chosen origin method."""
-
-    for i, pivot in enumerate(pivots):
-        if pivot is None:
-            continue
-
-        is_base = group_manager.get_group_manager().was_object_last_transformed_using_base(pivot)
-        if not is_base:
-            pivot.matrix_world.translation -= Vector(cogs[i])
-            
-        origin_vector = Vector(origins[i]) if origin_method_is_base else Vector(cogs[i])
-        pivot_world_rot = pivot.matrix_world.to_quaternion()
-        world_rot = pivot_world_rot @ rots[i]
-        rotation_matrix = world_rot.to_matrix().to_4x4()
+def _apply_transforms_to_pivots(list pivots, list group_names, results, bint origin_method_is_base):
+    """Apply position and rotation transforms to pivots using the chosen origin method.
 
-        world_cog = pivot.matrix_world @ Vector(cogs[i])
-        world_origin = pivot.matrix_world @ origin_vector
-        target_origin = world_cog + rotation_matrix @ (world_origin - world_cog)
-
-        local_cog = Vector(cogs[i])
-        local_origin = origin_vector
-        local_rotation_matrix = rots[i].to_matrix().to_4x4()
+    results is a STANDARDIZE_RESULT_DTYPE record array aligned with pivots and
+    group_names. All new transforms are computed in one typed pass; Blender is
+    then written once per pivot and once per child.
+    """
+    valid = results["valid"]
+    cdef list indices = [i for i, pivot in enumerate(pivots) if pivot is not None and valid[i]]
+    cdef Py_ssize_t count = len(indices)
+    if count == 0:
+        return
 
-        pre_rotate = Matrix.Translation(local_rotation_matrix @ (local_cog - local_origin)) @ local_rotation_matrix
-        post_translate = Matrix.Translation(-local_cog)
+    core_group_mgr = group_manager.get_group_manager()
+    cdef list applied_pivots = [pivots[i] for i in indices]
+    applied = results[indices]
+    last_used_base = np.array(
+        [core_group_mgr.was_group_last_transformed_using_base(group_names[i]) for i in indices],
+        dtype=np.uint8)
+
+    arena = shm_utils.get_staging_arena()
+    pivot_mats = arena.reserve("apply_pivot_matrices", np.float32, count * 16).reshape(count, 16)
+    transform_utils.gather_world_matrices(applied_pivots, pivot_mats, arena)
+    translations = arena.reserve("apply_translations", np.float64, count * 3).reshape(count, 3)
+    child_deltas = arena.reserve("apply_child_deltas", np.float64, count * 16).reshape(count, 4, 4)
+    transform_utils.compute_pivot_updates(
+        pivot_mats,
+        np.ascontiguousarray(applied["rot"]),
+        np.ascontiguousarray(applied["origin"]),
+        np.ascontiguousarray(applied["cog"]),
+        last_used_base, origin_method_is_base, translations, child_deltas)
+
+    cdef Py_ssize_t k
+    cdef list applied_objects = []
+    for k in range(count):
+        pivot = applied_pivots[k]
+        delta = Matrix(child_deltas[k].tolist())
         for child in pivot.children:
-            child.matrix_local = pre_rotate @ post_translate @ child.matrix_local
+            child.matrix_local = delta @ child.matrix_local
+        pivot.matrix_world.translation = translations[k].tolist()
+        applied_objects.extend(pivot.children_recursive)
 
-        pivot.matrix_world.translation = target_origin
+    # Their new matrices are recorded as synced once the depsgraph has evaluated them
+    transform_utils.get_transform_cache().mark_applied(applied_objects)
 
 def set_origin_and_preserve_children(obj, new_origin_local):
     """Move object origin to new_origin_world while preserving visual placement of mesh and children."""
@@ -117,183 +140,595 @@ def _build_group_surface_contexts(group_names, surface_context, classification_m
 
     return contexts
 
-def _standardize_synced_groups(synced_group_names, surface_contexts):
-    """Reclassify cached groups without sending mesh data."""
-
-    if not synced_group_names:
-        return {}
-
+cdef bint _is_alive(object obj):
+    """Return False for None or objects removed from the file since they were captured."""
+    if obj is None:
+        return False
+    try:
+        obj.name
+    except ReferenceError:
+        return False
+    return True
+
+cdef list _group_pointers(str group_name, object pivot):
+    """ID pointers whose updates mean the group changed: its collection, objects, their data and pivot."""
+    cdef list pointers = []
+    coll = bpy.data.collections.get(group_name)
+    if coll is not None:
+        pointers.append(coll.as_pointer())
+        for obj in coll.all_objects:
+            pointers.append(obj.as_pointer())
+            if obj.data is not None:
+                pointers.append(obj.data.as_pointer())
+    if _is_alive(pivot):
+        pointers.append(pivot.as_pointer())
+    return pointers
+
+def _finalize_shm_context(shm_context):
+    """Engine half of a filled standardize command; runs on an engine_task worker."""
+    return shm_context.finalize()
+
+def _run_group_tail_commands(list synced_group_names, list synced_surface_contexts):
+    """Engine calls issued after every chunk was uploaded; runs on a worker and must not touch bpy."""
+    synced_json = None
+    if synced_group_names:
+        synced_json = engine.standardize_synced_groups_command(synced_group_names, synced_surface_contexts)
+    surface_types_json = engine.get_surface_types_command()
+    return synced_json, surface_types_json
+
+
+cdef class GroupStandardizeJob:
+    """A standardize_groups call between submission and application.
+
+    New groups are uploaded in chunks planned by shm_utils.plan_upload_chunks().
+    Each chunk is its own prepare/finalize command. A chunk is only prepared
+    and filled after the previous one was collected, so a single engine
+    command is in flight and one chunk is resident in shared memory at a time.
+    Later chunks are filled on later modal ticks, after the user may have
+    edited the scene, so their groups are re-validated first and skipped
+    (left unsynced) if an object was removed or its geometry changed. After
+    the last chunk the synced-group and surface-type commands run. poll()
+    advances this pipeline and must be called on the main thread; finish()
+    applies the results once it is True.
+
+    Edits that land after a group's data was sent (the modal passes events
+    through) are seen through the change tracker's edit generations; finish()
+    leaves those groups unsynced and does not record their fingerprints.
+    """
 
-    final_response = json.loads(engine.standardize_synced_groups_command(synced_group_names, surface_contexts))
-    return final_response.get("groups", {})
+    cdef object _task
+    cdef object _task_fingerprints
+    cdef object _task_group_bytes
+    cdef list _chunks
+    cdef int _chunk_count
+    cdef int _chunks_done
+    cdef double _engine_seconds
+    cdef object _tail_result
+    cdef dict _new_group_results
+    cdef bint _origin_method_is_base
+    cdef list _mesh_groups
+    cdef list _full_groups
+    cdef list _group_names
+    cdef list _pivots
+    cdef list _surface_contexts
+    cdef list _synced_group_names
+    cdef list _synced_surface_contexts
+    cdef list _synced_pivots
+    cdef object _census
+    # object pointer -> (vert count, edge count) at aggregation, to detect later edits
+    cdef dict _captured_counts
+    # Groups dropped by re-validation; never uploaded, so they stay unsynced
+    cdef list _skipped_group_names
+    # group name -> (edit generation when its data was sent, ID pointers to watch)
+    cdef dict _watched
+    # Per collected chunk: group name -> fingerprints, recorded in finish() for clean groups
+    cdef list _chunk_fingerprints
+    cdef str _submission_mode
+
+    def __init__(self, bint origin_method_is_base, list mesh_groups, list full_groups, list group_names,
+                 list pivots, list surface_contexts, list synced_group_names, list synced_surface_contexts,
+                 list synced_pivots, object census, str submission_mode=shm_utils.SUBMIT_FULL) -> None:
+        self._task = None
+        self._task_fingerprints = None
+        self._task_group_bytes = None
+        self._engine_seconds = 0.0
+        self._tail_result = None
+        self._new_group_results = {}
+        self._origin_method_is_base = origin_method_is_base
+        self._mesh_groups = mesh_groups
+        self._full_groups = full_groups
+        self._group_names = group_names
+        self._pivots = pivots
+        self._surface_contexts = surface_contexts
+        self._synced_group_names = synced_group_names
+        self._synced_surface_contexts = synced_surface_contexts
+        self._synced_pivots = synced_pivots
+        self._census = census
+        self._submission_mode = submission_mode
+        self._chunks = shm_utils.plan_upload_chunks(mesh_groups, group_names, census)
+        self._captured_counts = {}
+        self._skipped_group_names = []
+        self._chunk_fingerprints = []
+        # The engine already holds the synced groups; edits from here on make its copy stale
+        tracker = get_change_tracker()
+        tracker.begin_watch()
+        self._watched = {}
+        for i in range(len(synced_group_names)):
+            self._watched[synced_group_names[i]] = (
+                tracker.get_edit_generation(), _group_pointers(synced_group_names[i], synced_pivots[i]))
+        if len(self._chunks) > 1:
+            for group in mesh_groups:
+                for obj in group:
+                    entry = census.entry(obj)
+                    self._captured_counts[obj.as_pointer()] = (entry.vert_count, entry.edge_count)
+        self._chunk_count = len(self._chunks)
+        self._chunks_done = 0
+
+    cdef list _valid_chunk_indices(self, Py_ssize_t start, Py_ssize_t end):
+        """Indices in [start, end) whose objects still match the counts captured at aggregation."""
+        cdef list valid = []
+        cdef list unchanged = []
+        cdef list stale = []
+        cdef dict counts = self._captured_counts
+        cdef Py_ssize_t i
+        cdef bint ok
+        cdef object entry
+        for i in range(start, end):
+            ok = _is_alive(self._pivots[i])
+            for obj in self._mesh_groups[i]:
+                if not ok:
+                    break
+                ok = _is_alive(obj) and obj.type == 'MESH'
+            if ok:
+                valid.append(i)
+            else:
+                stale.append(self._group_names[i])
+
+        # Evaluated meshes captured earlier may have been freed; recount against a fresh depsgraph
+        self._census.rebind(bpy.context.evaluated_depsgraph_get())
+        for i in valid:
+            ok = True
+            for obj in self._mesh_groups[i]:
+                entry = self._census.entry(obj)
+                if counts.get(obj.as_pointer()) != (entry.vert_count, entry.edge_count):
+                    ok = False
+                    break
+            if ok:
+                unchanged.append(i)
+            else:
+                stale.append(self._group_names[i])
 
-def standardize_groups(list selected_objects, str origin_method, str surface_context):
-    """Pro Edition: Classify selected groups via engine."""
+        self._skipped_group_names.extend(stale)
+        return unchanged
 
-    mesh_groups, full_groups, group_names, total_verts, total_edges, total_objects, pivots, synced_group_names, synced_pivots = selection_utils.aggregate_object_groups(selected_objects)
-    core_group_mgr = group_manager.get_group_manager()
-    origin_method_is_base = origin_method == "BASE"
+    cdef object _fill_chunk(self, Py_ssize_t start, Py_ssize_t end, bint validate):
+        """Prepare and fill one chunk; returns (shm_context, fingerprints, group_bytes) or None if nothing is left to send."""
+        cdef list indices
+        if not validate:
+            indices = list(range(start, end))
+        else:
+            indices = self._valid_chunk_indices(start, end)
+        if not indices:
+            return None
+        filled = shm_utils.fill_data_arrays(
+            [self._mesh_groups[i] for i in indices], [self._pivots[i] for i in indices], True,
+            [self._group_names[i] for i in indices], [self._surface_contexts[i] for i in indices],
+            self._census, self._submission_mode)
+        generation = get_change_tracker().get_edit_generation()
+        for i in indices:
+            self._watched[self._group_names[i]] = (generation, _group_pointers(self._group_names[i], self._pivots[i]))
+        return filled
+
+    cdef void _start_next(self):
+        cdef Py_ssize_t start
+        cdef Py_ssize_t end
+        cdef object filled = None
+        # The first chunk is filled right after aggregation; later ones may follow user edits
+        cdef bint validate = len(self._chunks) != self._chunk_count
+        while filled is None and self._chunks:
+            start, end = self._chunks.pop(0)
+            filled = self._fill_chunk(start, end, validate)
+            if filled is None:
+                self._chunks_done += 1
+        if filled is not None:
+            shm_context, self._task_fingerprints, self._task_group_bytes = filled
+            self._task = engine_task.EngineTask(_finalize_shm_context, shm_context)
+        else:
+            self._task_fingerprints = None
+            self._task = engine_task.EngineTask(
+                _run_group_tail_commands, self._synced_group_names, self._synced_surface_contexts)
+        self._task.start()
+
+    cdef void _collect(self):
+        result = self._task.result()
+        self._engine_seconds += self._task.elapsed()
+        if self._task_fingerprints is None:
+            self._tail_result = result
+        else:
+            # Fingerprints wait for finish(), which knows which groups were edited meanwhile
+            # Sent bytes count as soon as the engine accepted them, edited or not
+            final_response = shm_utils.decode_standardize_response(result, None, self._task_group_bytes)
+            if not bool(final_response.get("ok", True)):
+                error_msg = final_response.get("error", "Unknown engine error during standardize_groups")
+                raise RuntimeError(f"standardize_groups failed: {error_msg}")
+            self._chunk_fingerprints.append(self._task_fingerprints)
+            self._new_group_results.update(final_response["groups"])
+            self._chunks_done += 1
+        self._task = None
+
+    def start(self) -> GroupStandardizeJob:
+        self._start_next()
+        return self
+
+    def poll(self) -> bool:
+        """Advance the upload pipeline without blocking; True once every engine call returned."""
+        if self._tail_result is not None:
+            return True
+        if not self._task.done():
+            return False
+        self._collect()
+        if self._tail_result is not None:
+            return True
+        self._start_next()
+        return False
+
+    def wait(self) -> None:
+        while not self.poll():
+            self._task.wait()
+
+    def cancel(self) -> None:
+        """Stop waiting for the engine; touched groups are left unsynced and resend next run.
+
+        Chunks are only prepared right before they are finalized, so the one in
+        flight is the only engine command outstanding; its result is discarded.
+        """
+        if self._task is not None:
+            self._task.cancel()
+        self._chunks = []
+        get_change_tracker().end_watch()
+
+    def elapsed(self) -> float:
+        if self._task is None:
+            return self._engine_seconds
+        return self._engine_seconds + self._task.elapsed()
+
+    def progress(self) -> tuple:
+        """Return (uploaded chunks processed, total chunks)."""
+        return self._chunks_done, self._chunk_count
+
+    def group_count(self) -> int:
+        return len(self._group_names) + len(self._synced_group_names)
+
+    cdef void _record_fingerprints(self, set dirty):
+        for fingerprints in self._chunk_fingerprints:
+            if fingerprints:
+                engine_state.update_object_fingerprints(
+                    {name: value for name, value in fingerprints.items() if name not in dirty})
+        self._chunk_fingerprints = []
+
+    def skipped_group_names(self) -> list:
+        """Groups left out because they were edited or removed before their chunk was filled."""
+        return list(self._skipped_group_names)
+
+    def finish(self) -> None:
+        """Decode the engine responses and apply transforms and organization."""
+        if self._tail_result is None:
+            raise RuntimeError("Engine operation has not finished")
+        synced_json, surface_types_json = self._tail_result
+        instrumentation.add_stage_time(STAGE_ENGINE, self._engine_seconds)
+
+        # Decided before anything below edits the scene itself
+        tracker = get_change_tracker()
+        dirty = {name for name, (generation, pointers) in self._watched.items()
+                 if tracker.edited_since(pointers, generation)}
+        tracker.end_watch()
+        self._record_fingerprints(dirty)
+
+        core_group_mgr = group_manager.get_group_manager()
+        group_names = self._group_names
+        synced_group_names = self._synced_group_names
+
+        new_group_results = self._new_group_results
+        if new_group_results:
+            transformed_group_names = list(new_group_results.keys())
+
+            # Only the Pro depsgraph handler diffs against the membership snapshot
+            IF PIVOT_EDITION_PRO:
+                # Skipped chunks leave results sparse, so pair names with their groups by lookup
+                full_group_lookup = {group_names[i]: self._full_groups[i] for i in range(len(group_names))}
+                group_membership_snapshot = engine_state.build_group_membership_snapshot(
+                    [full_group_lookup[name] for name in transformed_group_names if name in full_group_lookup],
+                    [name for name in transformed_group_names if name in full_group_lookup])
+                engine_state.update_group_membership_snapshot(group_membership_snapshot, replace=False)
+
+        synced_group_results = {}
+        if synced_json is not None:
+            with instrumentation.stage(STAGE_JSON):
+                synced_group_results = json.loads(synced_json).get("groups", {})
+
+        all_group_results = {**new_group_results, **synced_group_results}
+        all_transformed_group_names = list(all_group_results.keys())
+
+        if all_transformed_group_names:
+            all_results = shm_utils.unpack_standardize_results(all_group_results, all_transformed_group_names)
+
+            pivot_lookup = {group_names[i]: self._pivots[i] for i in range(len(group_names))}
+            pivot_lookup.update({synced_group_names[i]: self._synced_pivots[i] for i in range(len(synced_group_names))})
+            all_pivots = []
+            for name in all_transformed_group_names:
+                pivot = pivot_lookup.get(name)
+                if not _is_alive(pivot):
+                    print(f"Warning: Pivot not found for group '{name}'")
+                    pivot = None
+                all_pivots.append(pivot)
+
+            with instrumentation.stage(STAGE_APPLY):
+                _apply_transforms_to_pivots(all_pivots, all_transformed_group_names, all_results, self._origin_method_is_base)
+            core_group_mgr.set_groups_last_origin_method_base(all_transformed_group_names, self._origin_method_is_base)
+
+        with instrumentation.stage(STAGE_JSON):
+            surface_types_response = json.loads(surface_types_json)
+
+        if not bool(surface_types_response.get("ok", True)):
+            error_msg = surface_types_response.get("error", "Unknown engine error during get_surface_types")
+            raise RuntimeError(f"get_surface_types failed: {error_msg}")
+
+        all_surface_types = surface_types_response.get("groups", {})
+
+        # --- Always organize ALL groups using surface types ---
+        if all_surface_types:
+            # Use the response order directly instead of converting to list and back
+            # This preserves the engine's ordering and prevents group/surface type misalignment
+            all_group_names = list(all_surface_types.keys())
+            surface_types = [all_surface_types[name]["surface_type"] for name in all_group_names]
+
+            # Verify we have matching counts to prevent misalignment
+            if len(all_group_names) != len(surface_types):
+                raise RuntimeError(f"Mismatch between group names ({len(all_group_names)}) and surface types ({len(surface_types)})")
+
+            core_group_mgr.update_managed_group_names(all_group_names)
+            # The engine also reports groups it holds from earlier runs; only the
+            # ones this job uploaded or re-standardized match the scene now.
+            # New names are adopted as synced, so skipped groups are unsynced again.
+            processed = set(new_group_results)
+            processed.update(synced_group_names)
+            core_group_mgr.set_groups_synced([name for name in all_group_names if name in processed and name not in dirty])
+            for name in self._skipped_group_names:
+                core_group_mgr.set_group_unsynced(name)
+            # Edited after their data was sent: the engine's result predates the edit
+            for name in dirty:
+                core_group_mgr.set_group_unsynced(name)
+
+            # Pass as parallel lists with verified alignment to avoid swapping
+            with instrumentation.stage(STAGE_ORGANIZE):
+                get_surface_manager().organize_groups_into_surfaces(all_group_names, surface_types)
+
+
+def begin_standardize_groups(list selected_objects, str origin_method, str surface_context,
+                             str submission_mode=shm_utils.SUBMIT_FULL):
+    """Read the selection, fill shared memory and start the engine on a worker thread.
+
+    Returns a GroupStandardizeJob; call finish() once poll() is True. Only the
+    first upload chunk is filled here; later chunks are filled as poll() runs.
+    submission_mode (shm_utils.SUBMIT_*) applies to newly uploaded groups;
+    synced groups keep the geometry the engine already holds.
+    """
+    if engine_task.has_active_task():
+        raise RuntimeError("Another engine operation is still running")
+    # Queued drops must land before the engine sees this selection's groups
+    get_command_queue().flush()
 
-    new_group_results = {}
-    transformed_group_names = []
+    with instrumentation.stage(STAGE_SELECTION):
+        mesh_groups, full_groups, group_names, total_verts, total_edges, total_objects, pivots, synced_group_names, synced_pivots, census = selection_utils.aggregate_object_groups(selected_objects)
+    instrumentation.add_count(COUNT_GROUPS, len(group_names) + len(synced_group_names))
 
     #Retain old classifications for user correction support
     classification_map = None
     if surface_context == "AUTO" and (group_names or synced_group_names):
         classification_map = get_surface_manager().collect_group_classifications()
 
-    if group_names:
-        surface_contexts = _build_group_surface_contexts(group_names, surface_context, classification_map)
-
-        final_response = shm_utils.create_data_arrays(
-            total_verts, total_edges, total_objects, mesh_groups, pivots, True, group_names, surface_contexts)
-
-        new_group_results = final_response["groups"]
-        transformed_group_names = list(new_group_results.keys())
-
-        group_membership_snapshot = engine_state.build_group_membership_snapshot(full_groups, transformed_group_names)
-        engine_state.update_group_membership_snapshot(group_membership_snapshot, replace=False)
-
+    surface_contexts = _build_group_surface_contexts(group_names, surface_context, classification_map)
     synced_surface_contexts = _build_group_surface_contexts(synced_group_names, surface_context, classification_map)
-    synced_group_results = _standardize_synced_groups(synced_group_names, synced_surface_contexts)
-
-    all_group_results = {**new_group_results, **synced_group_results}
-    all_transformed_group_names = list(all_group_results.keys())
-
-    if all_transformed_group_names:
-        all_rots = [Quaternion(all_group_results[name]["rot"]) for name in all_transformed_group_names]
-        all_origins = [tuple(all_group_results[name]["origin"]) for name in all_transformed_group_names]
-        all_cogs = [tuple(all_group_results[name]["cog"]) for name in all_transformed_group_names]
 
-        pivot_lookup = {group_names[i]: pivots[i] for i in range(len(group_names))}
-        pivot_lookup.update({synced_group_names[i]: synced_pivots[i] for i in range(len(synced_group_names))})
-        all_pivots = []
-        for name in all_transformed_group_names:
-            pivot = pivot_lookup.get(name)
-            if pivot is None:
-                print(f"Warning: Pivot not found for group '{name}'")
-            all_pivots.append(pivot)
+    job = GroupStandardizeJob(origin_method == "BASE", mesh_groups, full_groups, group_names, pivots,
+                              surface_contexts, synced_group_names, synced_surface_contexts, synced_pivots, census,
+                              submission_mode)
+    try:
+        return job.start()
+    except Exception:
+        job.cancel()
+        raise
 
-        _apply_transforms_to_pivots(all_pivots, all_origins, all_rots, all_cogs, origin_method_is_base)
-        core_group_mgr.set_groups_last_origin_method_base(all_transformed_group_names, origin_method_is_base)
 
-    surface_types_response = json.loads(engine.get_surface_types_command())
-    
-    if not bool(surface_types_response.get("ok", True)):
-        error_msg = surface_types_response.get("error", "Unknown engine error during get_surface_types")
-        raise RuntimeError(f"get_surface_types failed: {error_msg}")
-    
-    all_surface_types = surface_types_response.get("groups", {})
-    # print(all_surface_types)
-
-    # --- Always organize ALL groups using surface types ---
-    if all_surface_types:
-        # Use the response order directly instead of converting to list and back
-        # This preserves the engine's ordering and prevents group/surface type misalignment
-        all_group_names = list(all_surface_types.keys())
-        surface_types = [all_surface_types[name]["surface_type"] for name in all_group_names]
-        
-        # Verify we have matching counts to prevent misalignment
-        if len(all_group_names) != len(surface_types):
-            raise RuntimeError(f"Mismatch between group names ({len(all_group_names)}) and surface types ({len(surface_types)})")
-        
-        core_group_mgr.update_managed_group_names(all_group_names)
-        core_group_mgr.set_groups_synced(all_group_names)
-        
-        # Pass as parallel lists with verified alignment to avoid swapping
-        get_surface_manager().organize_groups_into_surfaces(all_group_names, surface_types)
-
-def _get_standardize_results(list objects, str surface_context="AUTO"):
-    """
-    Helper function to get standardization results from the engine.
-        
-    Returns mesh_objects, rots, origins, cogs
+@instrumentation.instrumented("standardize_groups")
+def standardize_groups(list selected_objects, str origin_method, str surface_context,
+                       str submission_mode=shm_utils.SUBMIT_FULL):
+    """Pro Edition: Classify selected groups via engine."""
+    job = begin_standardize_groups(selected_objects, origin_method, surface_context, submission_mode)
+    job.wait()
+    job.finish()
+
+
+cdef class ObjectStandardizeJob:
+    """A per-object standardize call between submission and decoding."""
+
+    cdef object _task
+    cdef list _mesh_objects
+    cdef list _object_names
+    # Position of each mesh object's result in object_names, or None if 1:1
+    cdef object _instance_of
+
+    def __init__(self, task, list mesh_objects, list object_names, instance_of=None) -> None:
+        self._task = task
+        self._mesh_objects = mesh_objects
+        self._object_names = object_names
+        self._instance_of = instance_of
+
+    def poll(self) -> bool:
+        return self._task is None or self._task.done()
+
+    def wait(self) -> None:
+        if self._task is not None:
+            self._task.wait()
+
+    def cancel(self) -> None:
+        if self._task is not None:
+            self._task.cancel()
+
+    def elapsed(self) -> float:
+        return self._task.elapsed() if self._task is not None else 0.0
+
+    def progress(self) -> tuple:
+        return (1 if self.poll() else 0), 1
+
+    def finish(self):
+        """Return (mesh_objects, records); records is None when nothing was sent."""
+        if self._task is None:
+            return [], None
+        final_json = self._task.result()
+        instrumentation.add_stage_time(STAGE_ENGINE, self._task.elapsed())
+        final_response = shm_utils.decode_standardize_response(final_json, {})
+
+        if not bool(final_response.get("ok", True)):
+            error_msg = final_response.get("error", "Unknown engine error during classify_objects")
+            raise RuntimeError(f"classify_objects failed: {error_msg}")
+
+        # Engine returns results as a dict keyed by object name; drop objects
+        # deleted while the engine was working.
+        results = final_response.get("results", {})
+        records = shm_utils.unpack_standardize_results(results, self._object_names)
+        if self._instance_of is not None:
+            # Fan shared-instance results out to every copy
+            records = records[self._instance_of]
+        alive = [i for i, obj in enumerate(self._mesh_objects) if _is_alive(obj)]
+        if len(alive) != len(self._mesh_objects):
+            return [self._mesh_objects[i] for i in alive], records[alive]
+        return self._mesh_objects, records
+
+
+def begin_object_standardize(list objects, str surface_context="AUTO", str submission_mode=shm_utils.SUBMIT_FULL):
+    """Fill shared memory for per-object standardization and start the engine.
+
+    Returns an ObjectStandardizeJob; finish() yields mesh_objects and a
+    STANDARDIZE_RESULT_DTYPE record array aligned with them (records with
+    valid == False had no engine result).
     """
     if not objects:
-        return [], [], [], []
+        return ObjectStandardizeJob(None, [], [])
     
-    # Validation: STANDARD edition only supports single object
-    if len(objects) > 1 and not edition_utils.is_pro_edition():
-        raise RuntimeError(f"STANDARD edition only supports single object classification, got {len(objects)}")
+    IF PIVOT_EDITION_STANDARD:
+        # Validation: STANDARD edition only supports single object
+        if len(objects) > 1:
+            raise RuntimeError(f"STANDARD edition only supports single object classification, got {len(objects)}")
+
+    if engine_task.has_active_task():
+        raise RuntimeError("Another engine operation is still running")
     
     # Filter to mesh objects only
     mesh_objects = [obj for obj in objects if obj.type == 'MESH']
     if not mesh_objects:
-        return [], [], [], []
+        return ObjectStandardizeJob(None, [], [])
     
     # Build mesh data for all objects
     mesh_groups = [[obj] for obj in mesh_objects]
     
-    # Use evaluated depsgraph to account for modifiers that may add verts/edges
-    depsgraph = bpy.context.evaluated_depsgraph_get()
-    total_verts = 0
-    total_edges = 0
-    for obj in mesh_objects:
-        eval_obj = obj.evaluated_get(depsgraph)
-        eval_mesh = eval_obj.data
-        total_verts += len(eval_mesh.vertices)
-        total_edges += len(eval_mesh.edges)
+    # Evaluated counts account for modifiers that may add verts/edges
+    with instrumentation.stage(STAGE_SELECTION):
+        census = MeshCensus()
+        total_verts, total_edges = census.totals(mesh_objects)
 
     if total_verts == 0:
-        return [], [], [], []
+        return ObjectStandardizeJob(None, [], [])
+
+    IF PIVOT_EDITION_PRO:
+        # Linked duplicates with the same world basis get one upload between them
+        representatives, instance_of = transform_utils.find_shared_instances(
+            mesh_objects, census, shm_utils.get_staging_arena())
+        upload_objects = [mesh_objects[i] for i in representatives]
+        if instance_of is not None:
+            mesh_groups = [[obj] for obj in upload_objects]
+            instrumentation.add_count(COUNT_SHARED_INSTANCES, len(mesh_objects) - len(upload_objects))
+    ELSE:
+        # A single object has nothing to share an upload with
+        upload_objects = mesh_objects
+        instance_of = None
     
     # --- Shared memory setup ---
-    object_names = [obj.name for obj in mesh_objects]
+    object_names = [obj.name for obj in upload_objects]
     # Map surface_context to engine-expected string
     if surface_context in ("AUTO", "0", "1", "2"):
         engine_surface_context = surface_context
     else:
         engine_surface_context = "AUTO"
-    surface_contexts = [engine_surface_context] * len(mesh_objects)
+    surface_contexts = [engine_surface_context] * len(upload_objects)
 
-    final_response = shm_utils.create_data_arrays(
-        total_verts, total_edges, len(mesh_objects), mesh_groups, [], False, object_names, surface_contexts)  # No pivots for objects
+    shm_context, _, _ = shm_utils.fill_data_arrays(
+        mesh_groups, [], False, object_names, surface_contexts, census, submission_mode)  # No pivots for objects
 
-    
-    if not bool(final_response.get("ok", True)):
-        error_msg = final_response.get("error", "Unknown engine error during classify_objects")
-        raise RuntimeError(f"classify_objects failed: {error_msg}")
-    
-    # --- Extract engine results ---
-    # Engine returns results as a dict keyed by object name
-    results = final_response.get("results", {})
-    rots = [Quaternion(results[obj.name]["rot"]) for obj in mesh_objects if obj.name in results]
-    origins = [tuple(results[obj.name]["origin"]) for obj in mesh_objects if obj.name in results]
-    cogs = [tuple(results[obj.name]["cog"]) for obj in mesh_objects if obj.name in results]
-    
-    return mesh_objects, rots, origins, cogs
+    task = engine_task.EngineTask(_finalize_shm_context, shm_context)
+    task.start()
+    return ObjectStandardizeJob(task, mesh_objects, object_names, instance_of)
 
 
+def _get_standardize_results(list objects, str surface_context="AUTO", str submission_mode=shm_utils.SUBMIT_FULL):
+    """
+    Helper function to get standardization results from the engine.
+        
+    Returns mesh_objects and a STANDARDIZE_RESULT_DTYPE record array aligned
+    with them (records with valid == False had no engine result).
+    """
+    job = begin_object_standardize(objects, surface_context, submission_mode)
+    job.wait()
+    return job.finish()
 
-def standardize_object_origins(list objects, str origin_method, str surface_context="AUTO"):
+
+@instrumentation.instrumented("standardize_object_origins")
+def standardize_object_origins(list objects, str origin_method, str surface_context="AUTO",
+                               str submission_mode=shm_utils.SUBMIT_FULL):
     """Standardize object origins."""
-    mesh_objects, rots, origins, cogs = _get_standardize_results(objects, surface_context)
+    mesh_objects, results = _get_standardize_results(objects, surface_context, submission_mode)
+    apply_object_origins(mesh_objects, results, origin_method)
+
+
+def apply_object_origins(list mesh_objects, results, str origin_method):
+    """Move origins to the engine results returned by ObjectStandardizeJob.finish()."""
     if not mesh_objects:
         return
-    new_origins = []
 
     if (origin_method == "BASE"):
-        new_origins = origins
+        new_origins = results["origin"]
     else:
-        new_origins = cogs
+        new_origins = results["cog"]
+    valid = results["valid"]
 
-    for i, obj in enumerate(mesh_objects):
-        if i < len(origins) and i < len(cogs):
+    with instrumentation.stage(STAGE_APPLY):
+        for i, obj in enumerate(mesh_objects):
+            if valid[i]:
 
-            # origin_vector = obj.matrix_world.translation + 
-            set_origin_and_preserve_children(obj, Vector(new_origins[i]))
-            bpy.context.scene.cursor.location = obj.matrix_world.translation
+                # origin_vector = obj.matrix_world.translation + 
+                set_origin_and_preserve_children(obj, Vector(new_origins[i]))
+                bpy.context.scene.cursor.location = obj.matrix_world.translation
     
 
-def standardize_object_rotations(list objects):
+@instrumentation.instrumented("standardize_object_rotations")
+def standardize_object_rotations(list objects, str submission_mode=shm_utils.SUBMIT_FULL):
     """Standardize object rotations."""
-    mesh_objects, rots, origins, cogs = _get_standardize_results(objects)
+    mesh_objects, results = _get_standardize_results(objects, "AUTO", submission_mode)
+    apply_object_rotations(mesh_objects, results)
+
+
+def apply_object_rotations(list mesh_objects, results):
+    """Rotate objects by the engine results returned by ObjectStandardizeJob.finish()."""
     if not mesh_objects:
         return
-    for i, obj in enumerate(mesh_objects):
-        if i < len(rots) and i < len(cogs):
-            rot = rots[i]
-            cog = Vector(cogs[i])
-            rotation_matrix = rot.to_matrix().to_4x4()
-            transform = Matrix.Translation(obj.matrix_world.translation + cog) @ rotation_matrix @ Matrix.Translation(-obj.matrix_world.translation - cog) @ obj.matrix_world
-            obj.matrix_world = transform
\ No newline at end of file
+    rots = results["rot"]
+    cogs = results["cog"]
+    valid = results["valid"]
+    with instrumentation.stage(STAGE_APPLY):
+        for i, obj in enumerate(mesh_objects):
+            if valid[i]:
+                rot = Quaternion(rots[i])
+                cog = Vector(cogs[i])
+                rotation_matrix = rot.to_matrix().to_4x4()
+                transform = Matrix.Translation(obj.matrix_world.translation + cog) @ rotation_matrix @ Matrix.Translation(-obj.matrix_world.translation - cog) @ obj.matrix_world
+                obj.matrix_world = transform
\ No newline at end of file
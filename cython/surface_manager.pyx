@@ -28,6 +28,8 @@ from typing import Any, Dict, Optional
 from .collection_manager import get_collection_manager
 from . import group_manager
 from . import classification
+from . import engine_state
+from .command_queue import get_command_queue
 import elbo_sdk_rust as engine
 
 # Property keys for collection metadata
@@ -42,10 +44,45 @@ cdef class SurfaceManager:
 
     cdef object _collection_manager
     cdef object _group_manager
+    # Root lookup cache. Only the name and pointer are kept so a stale cache
+    # never touches freed ID memory; the collection counts catch removals,
+    # duplicates and unlinked buckets that would need re-enforcing.
+    cdef str _root_name
+    cdef object _root_pointer
+    cdef Py_ssize_t _collection_count
+    cdef Py_ssize_t _root_child_count
 
     def __init__(self) -> None:
         self._collection_manager = get_collection_manager()
         self._group_manager = group_manager.get_group_manager()
+        self.invalidate_cache()
+
+    cpdef void invalidate_cache(self):
+        """Forget the cached root collection (undo, redo and file load)."""
+        self._root_name = None
+        self._root_pointer = None
+        self._collection_count = -1
+        self._root_child_count = -1
+
+    cdef object _cached_root(self):
+        """Return the cached root if it is still valid, else None; O(1) in collection count."""
+        if self._root_name is None:
+            return None
+        collections = bpy.data.collections
+        if len(collections) != self._collection_count:
+            return None
+        root = collections.get(self._root_name)
+        if root is None or root.as_pointer() != self._root_pointer:
+            return None
+        if len(root.children) != self._root_child_count:
+            return None
+        return root
+
+    cdef void _store_root(self, object pivot_root):
+        self._root_name = pivot_root.name
+        self._root_pointer = pivot_root.as_pointer()
+        self._collection_count = len(bpy.data.collections)
+        self._root_child_count = len(pivot_root.children)
 
     def _get_surface_display_name(self, str surface_key) -> str:
         """Get the display name for a surface key."""
@@ -58,8 +95,10 @@ cdef class SurfaceManager:
 
     def _get_and_enforce_root_collection(self):
         """Find or create the root classification collection and enforce structure."""
-        pivot_root = None
         cdef list classification_collections = []
+        pivot_root = self._cached_root()
+        if pivot_root is not None:
+            return pivot_root
         
         # Single loop: find root and collect all classification collections
         for coll in bpy.data.collections:
@@ -75,16 +114,22 @@ cdef class SurfaceManager:
         if pivot_root:
             # Enforce structure: Remove classification collections not under the pivot root
             collections_to_remove = [coll for coll in classification_collections if coll.name not in pivot_root.children]
-            for coll in collections_to_remove:
-                # Unlink from any parents first
+            if collections_to_remove:
+                # One pass to find every stray's parents, then unlink and remove
+                stray_names = {coll.name for coll in collections_to_remove}
+                stray_parents = []
                 for parent in bpy.data.collections:
-                    if coll.name in parent.children:
-                        parent.children.unlink(coll)
-                # Remove the collection
-                bpy.data.collections.remove(coll)
+                    for child in parent.children:
+                        if child.name in stray_names:
+                            stray_parents.append((parent, child))
+                for parent, child in stray_parents:
+                    parent.children.unlink(child)
+                for coll in collections_to_remove:
+                    bpy.data.collections.remove(coll)
 
             # Ensure each surface bucket exists so we can reclassify into it
             self._ensure_surface_collections_exist(pivot_root)
+            self._store_root(pivot_root)
         
         return pivot_root
 
@@ -137,9 +182,11 @@ cdef class SurfaceManager:
         return result
 
     def sync_group_classifications(self, dict group_surface_map) -> bint:
-        """Sync classifications with the engine."""
+        """Sync classifications with the engine, after any queued drops."""
+        # A queued drop sent after the set would discard the groups it just typed
+        get_command_queue().flush()
         try:
-            return engine.set_surface_types_command(group_surface_map)
+            return engine_state.timed_command("set_surface_types_command", engine.set_surface_types_command, group_surface_map)
         except RuntimeError:
             return False
 
@@ -168,22 +215,65 @@ cdef class SurfaceManager:
             self._collection_manager.ensure_collection_link(surface_coll, group_collection)
 
     def organize_groups_into_surfaces(self, list group_names, list surface_types) -> None:
-        """Organize multiple group collections into the surface hierarchy using parallel lists."""
-        
-        # Get and enforce the root collection (includes cleanup)
-        pivot_root = self._get_and_enforce_root_collection()
-        
+        """Organize multiple group collections into the surface hierarchy using parallel lists.
+
+        Reads the current group -> surface links once, then unlinks and links
+        only the groups whose surface changed.
+        """
+        cdef dict surface_by_key = {}
+        cdef dict current_parents = {}
         cdef int idx
         cdef str group_name
         cdef str surface_key
-        
+        cdef list parents
+
+        # Get and enforce the root collection (includes cleanup)
+        pivot_root = self._get_and_enforce_root_collection()
+        if not pivot_root:
+            return
+        pivot_root[CLASSIFICATION_ROOT_MARKER_PROP] = True
+
+        # Current state: surface key -> collection, group name -> surface collections
+        for surface_coll in pivot_root.children:
+            key = surface_coll.get(CLASSIFICATION_COLLECTION_PROP)
+            if key is not None:
+                surface_by_key.setdefault(str(key), surface_coll)
+            for child in surface_coll.children:
+                parents = current_parents.get(child.name)
+                if parents is None:
+                    current_parents[child.name] = [surface_coll]
+                else:
+                    parents.append(surface_coll)
+
         for idx, group_name in enumerate(group_names):
             group_coll = bpy.data.collections.get(group_name)
             if not group_coll:
                 continue
-            
+
             surface_key = str(surface_types[idx])
-            self.organize_group_into_surface(group_coll, surface_key, pivot_root)
+            target = surface_by_key.get(surface_key)
+            if target is None:
+                target = self.get_or_create_surface_collection(pivot_root, surface_key)
+                if not target:
+                    continue
+                surface_by_key[surface_key] = target
+                # A reused collection may already hold groups
+                for child in target.children:
+                    current_parents.setdefault(child.name, []).append(target)
+
+            parents = current_parents.get(group_name, [])
+            linked = False
+            for parent in parents:
+                if parent == target:
+                    linked = True
+                else:
+                    parent.children.unlink(group_coll)
+            if not linked:
+                try:
+                    target.children.link(group_coll)
+                except RuntimeError as e:
+                    print(f"[ERROR] Failed to link {group_name} to {target.name}: {e}")
+            current_parents[group_name] = [target]
 
     cpdef bint is_classification_collection(self, collection):
         """Check if a collection is a classification collection."""
@@ -0,0 +1,543 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+# transform_utils.pyx - batched world matrix gathering and typed transform kernels
+#
+# Matrices are stored as float32 rows of 16 values in Blender's native
+# column-major order (element (row, col) at col * 4 + row), which is the layout
+# produced by foreach_get("matrix_world").
+
+import bpy
+import numpy as np
+cimport numpy as cnp
+from libc.math cimport sqrt, fabs
+from libc.stdint cimport uint32_t
+from libc.stddef cimport size_t
+
+# Below this many objects, or when the selection is a small fraction of the
+# file, reading matrix_world per object is cheaper than a bulk foreach_get.
+cdef size_t _BULK_GATHER_MIN = 64
+cdef size_t _BULK_GATHER_RATIO = 32
+
+cdef double _SINGULAR_EPSILON = 1e-12
+
+
+cpdef void gather_world_matrices(list objects, cnp.ndarray out, object arena):
+    """Fill out (N, 16) with each object's matrix_world in column-major order.
+
+    Large batches read every object's matrix and session_uid with one
+    foreach_get each and pick rows by uid, so no mathutils objects are created.
+    """
+    cdef size_t count = len(objects)
+    cdef size_t total
+    cdef size_t i
+    if count == 0:
+        return
+
+    all_objects = bpy.data.objects
+    total = len(all_objects)
+    if count >= _BULK_GATHER_MIN and count * _BULK_GATHER_RATIO >= total:
+        all_uids = arena.reserve("gather_uids", np.int32, total)
+        all_objects.foreach_get("session_uid", all_uids)
+        wanted = arena.reserve("gather_wanted", np.int32, count)
+        for i in range(count):
+            wanted[i] = objects[i].session_uid
+        order = np.argsort(all_uids, kind="stable")
+        positions = np.searchsorted(all_uids, wanted, sorter=order)
+        positions = np.minimum(positions, total - 1)
+        rows = order[positions]
+        if np.array_equal(all_uids[rows], wanted):
+            all_mats = arena.reserve("gather_matrices", np.float32, total * 16)
+            all_objects.foreach_get("matrix_world", all_mats)
+            np.take(all_mats.reshape(total, 16), rows, axis=0, out=out)
+            return
+
+    cdef object matrix
+    cdef int col
+    for i in range(count):
+        matrix = objects[i].matrix_world
+        for col in range(4):
+            out[i, col * 4:col * 4 + 4] = matrix.col[col]
+
+
+cdef inline void _normalize_columns3(double m[3][3]) noexcept nogil:
+    # m is indexed [col][row] like Blender's float[3][3]
+    cdef int c
+    cdef double length
+    for c in range(3):
+        length = sqrt(m[c][0] * m[c][0] + m[c][1] * m[c][1] + m[c][2] * m[c][2])
+        if length > 0.0:
+            m[c][0] /= length
+            m[c][1] /= length
+            m[c][2] /= length
+
+
+cdef inline void _mat3_to_quat(double m[3][3], double q[4]) noexcept nogil:
+    """Quaternion (w, x, y, z) from a column-major 3x3, matching Matrix.to_quaternion()."""
+    cdef double n[3][3]
+    cdef int c, r
+    cdef double trace, s, length
+    for c in range(3):
+        for r in range(3):
+            n[c][r] = m[c][r]
+    _normalize_columns3(n)
+
+    # R(row, col) == n[col][row]
+    trace = n[0][0] + n[1][1] + n[2][2]
+    if trace > 0.0:
+        s = 2.0 * sqrt(trace + 1.0)
+        q[0] = 0.25 * s
+        q[1] = (n[1][2] - n[2][1]) / s
+        q[2] = (n[2][0] - n[0][2]) / s
+        q[3] = (n[0][1] - n[1][0]) / s
+    elif n[0][0] > n[1][1] and n[0][0] > n[2][2]:
+        s = 2.0 * sqrt(1.0 + n[0][0] - n[1][1] - n[2][2])
+        q[0] = (n[1][2] - n[2][1]) / s
+        q[1] = 0.25 * s
+        q[2] = (n[1][0] + n[0][1]) / s
+        q[3] = (n[2][0] + n[0][2]) / s
+    elif n[1][1] > n[2][2]:
+        s = 2.0 * sqrt(1.0 + n[1][1] - n[0][0] - n[2][2])
+        q[0] = (n[2][0] - n[0][2]) / s
+        q[1] = (n[1][0] + n[0][1]) / s
+        q[2] = 0.25 * s
+        q[3] = (n[2][1] + n[1][2]) / s
+    else:
+        s = 2.0 * sqrt(1.0 + n[2][2] - n[0][0] - n[1][1])
+        q[0] = (n[0][1] - n[1][0]) / s
+        q[1] = (n[2][0] + n[0][2]) / s
+        q[2] = (n[2][1] + n[1][2]) / s
+        q[3] = 0.25 * s
+
+    # Canonical hemisphere and unit length, as Blender does
+    if q[0] < 0.0:
+        q[0] = -q[0]
+        q[1] = -q[1]
+        q[2] = -q[2]
+        q[3] = -q[3]
+    length = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3])
+    if length > 0.0:
+        q[0] /= length
+        q[1] /= length
+        q[2] /= length
+        q[3] /= length
+    else:
+        q[0] = 1.0
+
+
+cdef inline void _load_basis(const float[:, ::1] mats, size_t row, double out[3][3]) noexcept nogil:
+    cdef int c, r
+    for c in range(3):
+        for r in range(3):
+            out[c][r] = mats[row, c * 4 + r]
+
+
+cdef inline bint _invert3(double m[3][3], double out[3][3]) noexcept nogil:
+    """Invert a column-major 3x3; returns False (and identity) when singular."""
+    cdef double det
+    cdef int c, r
+    # Cofactors expressed on the [col][row] layout
+    out[0][0] = m[1][1] * m[2][2] - m[2][1] * m[1][2]
+    out[0][1] = m[2][1] * m[0][2] - m[0][1] * m[2][2]
+    out[0][2] = m[0][1] * m[1][2] - m[1][1] * m[0][2]
+    out[1][0] = m[2][0] * m[1][2] - m[1][0] * m[2][2]
+    out[1][1] = m[0][0] * m[2][2] - m[2][0] * m[0][2]
+    out[1][2] = m[1][0] * m[0][2] - m[0][0] * m[1][2]
+    out[2][0] = m[1][0] * m[2][1] - m[2][0] * m[1][1]
+    out[2][1] = m[2][0] * m[0][1] - m[0][0] * m[2][1]
+    out[2][2] = m[0][0] * m[1][1] - m[1][0] * m[0][1]
+    det = m[0][0] * out[0][0] + m[1][0] * out[0][1] + m[2][0] * out[0][2]
+    if fabs(det) < _SINGULAR_EPSILON:
+        for c in range(3):
+            for r in range(3):
+                out[c][r] = 1.0 if c == r else 0.0
+        return False
+    for c in range(3):
+        for r in range(3):
+            out[c][r] /= det
+    return True
+
+
+cdef inline void _mul3(double a[3][3], double b[3][3], double out[3][3]) noexcept nogil:
+    # out = a @ b on [col][row] storage
+    cdef int c, r
+    for c in range(3):
+        for r in range(3):
+            out[c][r] = a[0][r] * b[c][0] + a[1][r] * b[c][1] + a[2][r] * b[c][2]
+
+
+def pack_relative_transforms(const float[:, ::1] world_mats, const float[:, ::1] pivot_mats,
+                             const uint32_t[::1] group_object_counts, bint use_pivots,
+                             float[::1] rotations, float[::1] scales, float[::1] offsets):
+    """Write per-object rotation (w, x, y, z), scale and pivot-relative offset.
+
+    world_mats holds one row per object, grouped contiguously per
+    group_object_counts. With use_pivots, rotation and offset are expressed in
+    the space of the group's pivot row in pivot_mats; otherwise rotation is the
+    world rotation and the offset is zero. Scale is always the world scale.
+    """
+    cdef size_t group_count = group_object_counts.shape[0]
+    cdef size_t g, i, obj_idx = 0
+    cdef uint32_t member
+    cdef int c, r
+    cdef double basis[3][3]
+    cdef double pivot_inv[3][3]
+    cdef double local[3][3]
+    cdef double quat[4]
+    cdef double delta[3]
+    cdef double pivot_t[3]
+
+    cdef size_t expected_objects = 0
+    for g in range(group_count):
+        expected_objects += group_object_counts[g]
+    if expected_objects > <size_t>world_mats.shape[0]:
+        raise ValueError("pack_relative_transforms: group counts exceed the number of matrices")
+    if world_mats.shape[0] and (rotations.shape[0] < world_mats.shape[0] * 4
+                                or scales.shape[0] < world_mats.shape[0] * 3
+                                or offsets.shape[0] < world_mats.shape[0] * 3):
+        raise ValueError("pack_relative_transforms: output buffers are too small")
+    if use_pivots and pivot_mats.shape[0] < group_count:
+        raise ValueError("pack_relative_transforms: missing pivot matrices")
+
+    with nogil:
+        for g in range(group_count):
+            if use_pivots:
+                _load_basis(pivot_mats, g, basis)
+                _invert3(basis, pivot_inv)
+                for r in range(3):
+                    pivot_t[r] = pivot_mats[g, 12 + r]
+            for member in range(group_object_counts[g]):
+                i = obj_idx
+                obj_idx += 1
+                _load_basis(world_mats, i, basis)
+
+                for c in range(3):
+                    scales[i * 3 + c] = sqrt(basis[c][0] * basis[c][0] + basis[c][1] * basis[c][1] + basis[c][2] * basis[c][2])
+
+                if use_pivots:
+                    _mul3(pivot_inv, basis, local)
+                    _mat3_to_quat(local, quat)
+                    for r in range(3):
+                        delta[r] = world_mats[i, 12 + r] - pivot_t[r]
+                    for r in range(3):
+                        offsets[i * 3 + r] = pivot_inv[0][r] * delta[0] + pivot_inv[1][r] * delta[1] + pivot_inv[2][r] * delta[2]
+                else:
+                    _mat3_to_quat(basis, quat)
+                    offsets[i * 3] = 0.0
+                    offsets[i * 3 + 1] = 0.0
+                    offsets[i * 3 + 2] = 0.0
+
+                for c in range(4):
+                    rotations[i * 4 + c] = quat[c]
+
+
+cdef inline void _quat_mul(double a[4], double b[4], double out[4]) noexcept nogil:
+    # Hamilton product a @ b on (w, x, y, z)
+    out[0] = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3]
+    out[1] = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2]
+    out[2] = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1]
+    out[3] = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]
+
+
+cdef inline void _quat_to_mat3(double q[4], double m[3][3]) noexcept nogil:
+    # Column-major rotation matrix of a unit quaternion (w, x, y, z)
+    cdef double w = q[0], x = q[1], y = q[2], z = q[3]
+    m[0][0] = 1.0 - 2.0 * (y * y + z * z)
+    m[0][1] = 2.0 * (x * y + w * z)
+    m[0][2] = 2.0 * (x * z - w * y)
+    m[1][0] = 2.0 * (x * y - w * z)
+    m[1][1] = 1.0 - 2.0 * (x * x + z * z)
+    m[1][2] = 2.0 * (y * z + w * x)
+    m[2][0] = 2.0 * (x * z + w * y)
+    m[2][1] = 2.0 * (y * z - w * x)
+    m[2][2] = 1.0 - 2.0 * (x * x + y * y)
+
+
+cdef inline void _mul3_vec(double m[3][3], double v[3], double out[3]) noexcept nogil:
+    cdef int r
+    for r in range(3):
+        out[r] = m[0][r] * v[0] + m[1][r] * v[1] + m[2][r] * v[2]
+
+
+def compute_pivot_updates(const float[:, ::1] pivot_mats, const double[:, ::1] rots,
+                          const double[:, ::1] origins, const double[:, ::1] cogs,
+                          const unsigned char[::1] last_used_base, bint origin_method_is_base,
+                          double[:, ::1] out_translations, double[:, :, ::1] out_child_deltas):
+    """Compute each pivot's new world translation and the delta for its children.
+
+    For pivot g with world basis P, translation t, engine rotation q, cog c and
+    chosen origin o, children are re-placed with matrix_local = D @ matrix_local
+    where D = [R(q) | -R(q) o] (row-major in out_child_deltas), and the pivot
+    moves to world_cog + R(q_P q) P (o - c). Groups last transformed with the
+    VOLUME method first have t shifted back by c, as the per-pivot path did.
+    """
+    cdef size_t count = pivot_mats.shape[0]
+    cdef size_t g
+    cdef int c, r
+    cdef double basis[3][3]
+    cdef double local_rot[3][3]
+    cdef double world_rot_m[3][3]
+    cdef double pivot_q[4]
+    cdef double engine_q[4]
+    cdef double world_q[4]
+    cdef double translation[3]
+    cdef double origin[3]
+    cdef double cog[3]
+    cdef double diff[3]
+    cdef double tmp[3]
+    cdef double world_cog[3]
+    cdef double rotated[3]
+
+    if (rots.shape[0] < count or origins.shape[0] < count or cogs.shape[0] < count
+            or last_used_base.shape[0] < count or out_translations.shape[0] < count
+            or out_child_deltas.shape[0] < count):
+        raise ValueError("compute_pivot_updates: input and output lengths differ")
+
+    with nogil:
+        for g in range(count):
+            _load_basis(pivot_mats, g, basis)
+            for r in range(3):
+                translation[r] = pivot_mats[g, 12 + r]
+                cog[r] = cogs[g, r]
+                origin[r] = origins[g, r] if origin_method_is_base else cogs[g, r]
+                if not last_used_base[g]:
+                    translation[r] -= cog[r]
+            for c in range(4):
+                engine_q[c] = rots[g, c]
+
+            # Pivot: world_cog + R_world @ (world_origin - world_cog)
+            _mat3_to_quat(basis, pivot_q)
+            _quat_mul(pivot_q, engine_q, world_q)
+            _quat_to_mat3(world_q, world_rot_m)
+            _mul3_vec(basis, cog, world_cog)
+            for r in range(3):
+                world_cog[r] += translation[r]
+                diff[r] = origin[r] - cog[r]
+            _mul3_vec(basis, diff, tmp)
+            _mul3_vec(world_rot_m, tmp, rotated)
+            for r in range(3):
+                out_translations[g, r] = world_cog[r] + rotated[r]
+
+            # Children: T(R (c - o)) @ R @ T(-c) == [R | -R o]
+            _quat_to_mat3(engine_q, local_rot)
+            _mul3_vec(local_rot, origin, tmp)
+            for r in range(3):
+                for c in range(3):
+                    out_child_deltas[g, r, c] = local_rot[c][r]
+                out_child_deltas[g, r, 3] = -tmp[r]
+                out_child_deltas[g, 3, r] = 0.0
+            out_child_deltas[g, 3, 3] = 1.0
+
+
+# ---------------------------------------------------------------------------
+# Instance dedupe
+# ---------------------------------------------------------------------------
+
+# Largest per-element difference in the world 3x3 treated as "unchanged"
+cdef float _TRANSFORM_EPSILON = 1e-5
+
+# Basis columns (column-major 3x3) used to key shared instances
+cdef list _BASIS_COLUMNS = [0, 1, 2, 4, 5, 6, 8, 9, 10]
+
+
+def find_shared_instances(list objects, object census, object arena):
+    """Collapse objects whose standardize results are guaranteed identical.
+
+    Per-object results (rotation, origin and COG offsets) depend only on the
+    evaluated mesh and the world rotation/scale, not on the translation. Linked
+    duplicates without modifiers share one evaluated mesh, so objects with the
+    same evaluated mesh pointer and a matching world 3x3 (to _TRANSFORM_EPSILON)
+    need uploading only once.
+
+    Returns (representatives, instance_of) where representatives is a list of
+    indices into objects and instance_of maps every object to its position
+    in representatives (None when every object is unique).
+    """
+    cdef Py_ssize_t count = len(objects)
+    cdef Py_ssize_t i
+    cdef dict seen = {}
+    cdef list representatives = []
+    if count < 2:
+        return list(range(count)), None
+
+    mats = arena.reserve("instance_matrices", np.float32, count * 16).reshape(count, 16)
+    gather_world_matrices(objects, mats, arena)
+    basis_keys = np.rint(mats[:, _BASIS_COLUMNS] / _TRANSFORM_EPSILON).astype(np.int64)
+
+    instance_of = np.empty(count, dtype=np.intp)
+    for i in range(count):
+        key = (census.eval_mesh(objects[i]).as_pointer(), basis_keys[i].tobytes())
+        rep = seen.get(key)
+        if rep is None:
+            rep = len(representatives)
+            seen[key] = rep
+            representatives.append(i)
+        instance_of[i] = rep
+
+    if len(representatives) == count:
+        return representatives, None
+    return representatives, instance_of
+
+
+# ---------------------------------------------------------------------------
+# Transform cache
+# ---------------------------------------------------------------------------
+
+cdef Py_ssize_t _TRANSFORM_CACHE_MIN_SLOTS = 64
+
+
+cdef class TransformCache:
+    """Last-synced world matrices in one contiguous float32 block.
+
+    Every object gets a stable slot (keyed by as_pointer()) on first sight.
+    A generation counter makes invalidate() O(1); slots whose generation is
+    stale hold no value. Pointers do not survive undo or file load, so callers
+    clear() the cache on those events.
+    """
+
+    cdef dict _slots
+    cdef cnp.ndarray _matrices
+    cdef cnp.ndarray _generations
+    cdef uint32_t _generation
+    cdef Py_ssize_t _count
+    # Objects a standardize just transformed, stored by store_applied()
+    cdef list _applied
+
+    def __init__(self) -> None:
+        self._applied = []
+        self._slots = {}
+        self._matrices = np.zeros((0, 16), dtype=np.float32)
+        self._generations = np.zeros(0, dtype=np.uint32)
+        self._generation = 1
+        self._count = 0
+
+    cdef Py_ssize_t _slot(self, object obj):
+        cdef object key = obj.as_pointer()
+        cdef object slot = self._slots.get(key)
+        cdef Py_ssize_t capacity = self._matrices.shape[0]
+        cdef Py_ssize_t new_capacity
+        if slot is not None:
+            return <Py_ssize_t>slot
+        if self._count == capacity:
+            new_capacity = max(_TRANSFORM_CACHE_MIN_SLOTS, capacity * 2)
+            matrices = np.zeros((new_capacity, 16), dtype=np.float32)
+            matrices[:capacity] = self._matrices
+            generations = np.zeros(new_capacity, dtype=np.uint32)
+            generations[:capacity] = self._generations
+            self._matrices = matrices
+            self._generations = generations
+        self._slots[key] = self._count
+        self._count += 1
+        return self._count - 1
+
+    cdef cnp.ndarray _assign_slots(self, list objects, object arena):
+        cdef Py_ssize_t count = len(objects)
+        cdef cnp.ndarray slots = arena.reserve("transform_cache_slots", np.intp, count)
+        cdef Py_ssize_t i
+        for i in range(count):
+            slots[i] = self._slot(objects[i])
+        return slots
+
+    cpdef cnp.ndarray basis_changed(self, list objects, object arena):
+        """Return a uint8 mask of objects whose world rotation/scale left the cached value.
+
+        Objects without a valid cached matrix have their current one recorded
+        and are reported unchanged. Translation is ignored.
+        """
+        cdef Py_ssize_t count = len(objects)
+        cdef cnp.ndarray changed = np.zeros(count, dtype=np.uint8)
+        if count == 0:
+            return changed
+
+        cdef cnp.ndarray current = arena.reserve("transform_cache_current", np.float32, count * 16).reshape(count, 16)
+        gather_world_matrices(objects, current, arena)
+        cdef cnp.ndarray slots = self._assign_slots(objects, arena)
+
+        cdef float[:, ::1] cur_mv = current
+        cdef float[:, ::1] cached_mv = self._matrices
+        cdef uint32_t[::1] gen_mv = self._generations
+        cdef Py_ssize_t[::1] slot_mv = slots
+        cdef unsigned char[::1] changed_mv = changed
+        cdef uint32_t generation = self._generation
+        cdef Py_ssize_t i, s
+        cdef int k, c, r
+        cdef bint differs
+        with nogil:
+            for i in range(count):
+                s = slot_mv[i]
+                if gen_mv[s] != generation:
+                    for k in range(16):
+                        cached_mv[s, k] = cur_mv[i, k]
+                    gen_mv[s] = generation
+                    continue
+                # Upper-left 3x3 only (column-major, so skip each column's 4th row)
+                differs = False
+                for c in range(3):
+                    for r in range(3):
+                        if fabs(cur_mv[i, c * 4 + r] - cached_mv[s, c * 4 + r]) > _TRANSFORM_EPSILON:
+                            differs = True
+                changed_mv[i] = differs
+        return changed
+
+    cpdef void store(self, list objects, object arena):
+        """Record the current world matrices of objects as their synced values."""
+        cdef Py_ssize_t count = len(objects)
+        if count == 0:
+            return
+        cdef cnp.ndarray current = arena.reserve("transform_cache_current", np.float32, count * 16).reshape(count, 16)
+        gather_world_matrices(objects, current, arena)
+        cdef cnp.ndarray slots = self._assign_slots(objects, arena)
+        self._matrices[slots] = current
+        self._generations[slots] = self._generation
+
+    cpdef void mark_applied(self, list objects):
+        """Queue objects whose transforms were just written, for store_applied()."""
+        self._applied.extend(objects)
+
+    cpdef void store_applied(self, object arena):
+        """Record the evaluated matrices of the queued objects; other slots keep their values."""
+        cdef list alive = []
+        for obj in self._applied:
+            try:
+                obj.as_pointer()
+            except ReferenceError:
+                continue
+            alive.append(obj)
+        self._applied = []
+        self.store(alive, arena)
+
+    cpdef void invalidate(self):
+        """Drop every cached value but keep slot assignments."""
+        self._generation += 1
+
+    cpdef void clear(self):
+        """Forget slots and values (IDs were reallocated)."""
+        self._applied = []
+        self._slots.clear()
+        self._count = 0
+        self._generations[:] = 0
+        self._generation = 1
+
+    def __len__(self) -> int:
+        return self._count
+
+
+cdef TransformCache _transform_cache = TransformCache()
+
+cpdef TransformCache get_transform_cache():
+    """Get the global transform cache used by the depsgraph handlers."""
+    return _transform_cache
@@ -20,14 +20,22 @@ __version__ = "1.0.0"
 try:
     from . import edition_utils
     from . import engine_state
+    from . import change_tracker
+    from . import engine_task
+    from . import instrumentation
     from . import classification
     from . import collection_manager
+    from . import command_queue
     
     from . import group_manager
+    from . import hierarchy_index
+    from . import layout
+    from . import mesh_census
     from . import selection_utils
     from . import shm_utils
     
     from . import surface_manager
+    from . import transform_utils
     from . import standardize
 except ImportError as e:
     # Useful for debugging Blender console issues
@@ -36,13 +44,21 @@ except ImportError as e:
 
 
 __all__ = [
+    "change_tracker",
     "classification",
     "collection_manager",
+    "command_queue",
     "edition_utils",
     "engine_state",
+    "engine_task",
     "group_manager",
+    "hierarchy_index",
+    "instrumentation",
+    "layout",
+    "mesh_census",
     "selection_utils",
     "shm_utils",
     "standardize",
     "surface_manager",
+    "transform_utils",
 ]
@@ -25,6 +25,10 @@ from .classes import SceneAttributes
 from bpy.props import PointerProperty
 
 from pivot_lib import group_manager
+from pivot_lib import change_tracker
+from pivot_lib import surface_manager
+from pivot_lib import hierarchy_index
+from pivot_lib import layout
 from . import handlers
 from .operators.operators import (
     Pivot_OT_Organize_Classified_Objects,
@@ -36,7 +40,7 @@ from .operators.object_classification import (
     Pivot_OT_Set_Origin_Selected_Objects,
     Pivot_OT_Align_Facing_Selected_Objects,
 )
-from .ui import Pivot_PT_Standard_Panel, Pivot_PT_Pro_Panel, Pivot_PT_Status_Panel, Pivot_PT_Configuration_Panel
+from .ui import Pivot_PT_Standard_Panel, Pivot_PT_Pro_Panel, Pivot_PT_Status_Panel, Pivot_PT_Configuration_Panel, Pivot_PT_Performance_Panel, Pivot_PT_Engine_Panel
 
 classesToRegister = (
     SceneAttributes,
@@ -55,6 +59,11 @@ def _reset_sync_state() -> None:
     group_mgr = group_manager.get_group_manager()
     group_mgr.reset_state()
     engine_state.update_group_membership_snapshot({}, replace=True)
+    engine_state.clear_object_fingerprints()
+    change_tracker.get_change_tracker().reset()
+    surface_manager.get_surface_manager().invalidate_cache()
+    hierarchy_index.get_hierarchy_index().invalidate()
+    layout.get_shelf_layout().reset()
     handlers.clear_previous_scales()
 
 
@@ -98,6 +107,7 @@ def register():
     # Stop any running engine from previous edition
     try:
         engine.stop_engine()
+        engine_state.clear_group_uploads()
     except Exception as e:
         print(f"[Pivot] Note: Could not stop engine during register: {e}")
     
@@ -110,7 +120,7 @@ def register():
     pivot_dir = os.path.dirname(__file__)
     bin_dir = os.path.join(pivot_dir, "bin")
     engine.set_engine_dir(bin_dir)
-    engine.start_engine()
+    handlers.start_engine()
 
     is_pro = False
     try:
@@ -141,17 +151,30 @@ def register():
     _register_bpy_class(Pivot_PT_Standard_Panel)
 
     _register_bpy_class(Pivot_PT_Pro_Panel)
+    _register_bpy_class(Pivot_PT_Performance_Panel)
+    _register_bpy_class(Pivot_PT_Engine_Panel)
 
     # Register persistent handlers for engine lifecycle management
     if handlers.on_load_pre not in bpy.app.handlers.load_pre:
         bpy.app.handlers.load_pre.append(handlers.on_load_pre)
     if handlers.on_load_post not in bpy.app.handlers.load_post:
         bpy.app.handlers.load_post.append(handlers.on_load_post)
+    if handlers.on_save_pre not in bpy.app.handlers.save_pre:
+        bpy.app.handlers.save_pre.append(handlers.on_save_pre)
     
     # Only register depsgraph update handler for Pro edition
     if is_pro:
         if handlers.on_depsgraph_update not in bpy.app.handlers.depsgraph_update_post:
             bpy.app.handlers.depsgraph_update_post.append(handlers.on_depsgraph_update)
+        change_tracker.get_change_tracker().subscribe()
+        # The depsgraph handler keeps the index current, so it may cache across polls
+        hierarchy_index.get_hierarchy_index().set_tracking(True)
+
+    # Both editions run modal jobs that undo must abort
+    if handlers.on_undo_redo not in bpy.app.handlers.undo_post:
+        bpy.app.handlers.undo_post.append(handlers.on_undo_redo)
+    if handlers.on_undo_redo not in bpy.app.handlers.redo_post:
+        bpy.app.handlers.redo_post.append(handlers.on_undo_redo)
 
     
 
@@ -159,6 +182,8 @@ def register():
 def unregister():
     print("Unregistering Pivot")
     
+    _unregister_bpy_class(Pivot_PT_Engine_Panel)
+    _unregister_bpy_class(Pivot_PT_Performance_Panel)
     _unregister_bpy_class(Pivot_PT_Pro_Panel)
     _unregister_bpy_class(Pivot_PT_Standard_Panel)
     _unregister_bpy_class(Pivot_PT_Status_Panel)
@@ -174,14 +199,23 @@ def unregister():
         bpy.app.handlers.load_pre.remove(handlers.on_load_pre)
     if handlers.on_load_post in bpy.app.handlers.load_post:
         bpy.app.handlers.load_post.remove(handlers.on_load_post)
+    if handlers.on_save_pre in bpy.app.handlers.save_pre:
+        bpy.app.handlers.save_pre.remove(handlers.on_save_pre)
     # Only remove depsgraph update handler if it's registered (was only added for Pro edition)
     if handlers.on_depsgraph_update in bpy.app.handlers.depsgraph_update_post:
         bpy.app.handlers.depsgraph_update_post.remove(handlers.on_depsgraph_update)
+    change_tracker.get_change_tracker().unsubscribe()
+    hierarchy_index.get_hierarchy_index().set_tracking(False)
+    if handlers.on_undo_redo in bpy.app.handlers.undo_post:
+        bpy.app.handlers.undo_post.remove(handlers.on_undo_redo)
+    if handlers.on_undo_redo in bpy.app.handlers.redo_post:
+        bpy.app.handlers.redo_post.remove(handlers.on_undo_redo)
 
     # Perform cleanup as if we're unloading a file
     _reset_sync_state()
     handlers.on_load_pre(None)
     engine.stop_engine()
+    engine_state.clear_group_uploads()
 
 
 if __name__ == "__main__":
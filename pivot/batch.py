@@ -0,0 +1,196 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Headless batch standardization of .blend files.
+
+Run with the add-on enabled in Blender's preferences:
+
+    blender --background --python <addon dir>/batch.py -- \\
+        --jobs 4 --report batch_report.json library/*.blend
+
+Each file is opened, every group in its Source Collection is standardized
+and organized, and the file is saved in place (or into --output-dir). A
+single engine process is kept alive across all files of one Blender process;
+--jobs N splits the file list across N Blender processes, each with its own
+engine.
+"""
+
+import argparse
+import importlib
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+import bpy
+
+
+def _parse_args(argv):
+    parser = argparse.ArgumentParser(prog="batch.py", description="Pivot batch standardization")
+    parser.add_argument("files", nargs="+", help=".blend files to process")
+    parser.add_argument("--jobs", type=int, default=1, help="Number of Blender processes to run in parallel")
+    parser.add_argument("--output-dir", default=None, help="Save results here instead of overwriting the inputs")
+    parser.add_argument("--origin-method", choices=("BASE", "VOLUME"), default=None,
+                        help="Override each file's origin method")
+    parser.add_argument("--surface-context", default=None, help="Override each file's surface context")
+    parser.add_argument("--submission-mode", choices=("FULL", "POINTS", "SAMPLED"), default=None,
+                        help="Override each file's geometry submission mode")
+    parser.add_argument("--no-organize", action="store_true", help="Skip organizing after standardization")
+    parser.add_argument("--report", default=None, help="JSON report path (stdout when omitted)")
+    return parser.parse_args(argv)
+
+
+def _addon_package():
+    """Return the package name of the enabled add-on that contains this file."""
+    addon_dir = os.path.dirname(os.path.abspath(__file__))
+    for name in bpy.context.preferences.addons.keys():
+        module = sys.modules.get(name)
+        module_file = getattr(module, "__file__", None)
+        if module_file and os.path.dirname(os.path.abspath(module_file)) == addon_dir:
+            return name
+    raise RuntimeError("The Pivot add-on must be enabled to run batch standardization")
+
+
+# ---------------------------------------------------------------------------
+# Worker: one Blender process, one engine
+# ---------------------------------------------------------------------------
+
+def _process_file(path, args, standardize, organize_op):
+    bpy.ops.wm.open_mainfile(filepath=path)
+    scene = bpy.context.scene
+    objects_collection = scene.pivot.objects_collection or scene.collection
+    objects = [obj for obj in objects_collection.all_objects if obj.type == 'MESH']
+
+    origin_method = args.origin_method or scene.pivot.origin_method
+    surface_context = args.surface_context or scene.pivot.surface_type
+    submission_mode = args.submission_mode or scene.pivot.submission_mode
+
+    result = {"file": path, "objects": len(objects)}
+    start = time.perf_counter()
+    if objects:
+        standardize.standardize_groups(objects, origin_method, surface_context, submission_mode)
+        if not args.no_organize:
+            organize_op()
+
+    output_path = path
+    if args.output_dir:
+        output_path = os.path.join(args.output_dir, os.path.basename(path))
+        bpy.ops.wm.save_as_mainfile(filepath=output_path, copy=True)
+    else:
+        bpy.ops.wm.save_mainfile()
+    result["output"] = output_path
+    result["seconds"] = time.perf_counter() - start
+    return result
+
+
+def _run_worker(args):
+    package = _addon_package()
+    handlers = importlib.import_module(package + ".handlers")
+    operators = importlib.import_module(package + ".operators.operators")
+    from pivot_lib import edition_utils, standardize
+
+    if not edition_utils.is_pro_edition():
+        raise RuntimeError("Batch standardization requires the Pro edition")
+
+    category, op_name = operators.Pivot_OT_Organize_Classified_Objects.bl_idname.split(".")
+    organize_op = getattr(getattr(bpy.ops, category), op_name)
+
+    if args.output_dir:
+        os.makedirs(args.output_dir, exist_ok=True)
+
+    results = []
+    handlers.set_keep_engine_alive(True)
+    try:
+        for path in args.files:
+            try:
+                results.append(_process_file(os.path.abspath(path), args, standardize, organize_op))
+            except Exception as e:
+                print(f"[Pivot Batch] {path} failed: {e}")
+                results.append({"file": path, "error": str(e)})
+    finally:
+        handlers.set_keep_engine_alive(False)
+    return results
+
+
+# ---------------------------------------------------------------------------
+# Parent: split files across worker processes
+# ---------------------------------------------------------------------------
+
+def _worker_command(files, args, report_path):
+    command = [bpy.app.binary_path, "--background", "--python-exit-code", "1",
+               "--python", os.path.abspath(__file__), "--", "--report", report_path]
+    if args.output_dir:
+        command += ["--output-dir", args.output_dir]
+    if args.origin_method:
+        command += ["--origin-method", args.origin_method]
+    if args.surface_context:
+        command += ["--surface-context", args.surface_context]
+    if args.submission_mode:
+        command += ["--submission-mode", args.submission_mode]
+    if args.no_organize:
+        command.append("--no-organize")
+    return command + files
+
+
+def _run_parallel(args):
+    jobs = min(args.jobs, len(args.files))
+    # Round-robin keeps the large and small files of a sorted library mixed
+    slices = [args.files[i::jobs] for i in range(jobs)]
+    results = []
+    with tempfile.TemporaryDirectory(prefix="pivot_batch_") as tmp_dir:
+        processes = []
+        for i, files in enumerate(slices):
+            report_path = os.path.join(tmp_dir, f"worker_{i}.json")
+            processes.append((subprocess.Popen(_worker_command(files, args, report_path)), files, report_path))
+
+        for process, files, report_path in processes:
+            code = process.wait()
+            if os.path.exists(report_path):
+                with open(report_path) as f:
+                    results.extend(json.load(f))
+            else:
+                results.extend({"file": path, "error": f"worker exited with code {code}"} for path in files)
+    return results
+
+
+def main(argv=None):
+    if argv is None:
+        argv = sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else []
+    args = _parse_args(argv)
+
+    start = time.perf_counter()
+    if args.jobs > 1 and len(args.files) > 1:
+        results = _run_parallel(args)
+    else:
+        results = _run_worker(args)
+
+    failed = [r for r in results if "error" in r]
+    print(f"[Pivot Batch] Processed {len(results)} files in {time.perf_counter() - start:.2f}s, {len(failed)} failed")
+
+    text = json.dumps(results, indent=2)
+    if args.report:
+        with open(args.report, "w") as f:
+            f.write(text)
+    else:
+        print(text)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -30,6 +30,8 @@ LABEL_ROOM_COLLECTION = "Room:"
 LABEL_SURFACE_TYPE = "Surface Context:"
 LABEL_SURFACE_CONTEXT = "Surface Context:"
 LABEL_ORIGIN_METHOD = "Origin Method:"
+LABEL_SUBMISSION_MODE = "Geometry Sent:"
+LABEL_LAYOUT_MODE = "Arrange Layout:"
 LABEL_LICENSE_TYPE = "License:"
 
 # Marker property to identify classification collections
@@ -100,3 +102,22 @@ class SceneAttributes(PropertyGroup):
         ],
         default='BASE',
     )
+    submission_mode: EnumProperty(
+        name=LABEL_SUBMISSION_MODE.rstrip(":"),
+        description="Sets how much geometry is sent to the engine for newly standardized assets. 'Full' sends every vertex and edge, 'Points' drops edges, and 'Sampled' sends a bounded, evenly spread subset of each object's vertices, which is much faster on dense meshes at a small cost in precision",
+        items=[
+            ('FULL', 'Full', 'Every vertex and edge'),
+            ('POINTS', 'Points', 'Vertices only'),
+            ('SAMPLED', 'Sampled', 'Bounded spatial subsample of the vertices'),
+        ],
+        default='FULL',
+    )
+    layout_mode: EnumProperty(
+        name=LABEL_LAYOUT_MODE.rstrip(":"),
+        description="Sets how Arrange Viewport places groups. 'Rows' lets the engine lay out every group from scratch, while 'Packed' packs groups by footprint into one block per surface class and only moves groups that are new or no longer fit their previous spot",
+        items=[
+            ('ENGINE', 'Rows', 'Engine row layout'),
+            ('SHELF', 'Packed', 'Incremental footprint packing'),
+        ],
+        default='ENGINE',
+    )
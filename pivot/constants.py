@@ -31,6 +31,12 @@ WRITE_SURFACES = "writeSurfaces"
 SELECT_SEATING = "selectSeating"
 WRITE_SEATING = "writeSeating"
 
+# Developer-only: a worker thread count in PIVOT_DEV_ENGINE_THREADS is forwarded
+# to the engine process as ELBO_ENGINE_THREADS. Shipped engines do not read it;
+# it exists for testing engine builds that do.
+ENV_DEV_ENGINE_THREADS = "PIVOT_DEV_ENGINE_THREADS"
+ENV_ENGINE_THREADS = "ELBO_ENGINE_THREADS"
+
 #Attributes
 FACE_ATTR_IS_SEATING = "isSeating"
 FACE_ATTR_IS_SURFACE = "isSurface"
@@ -44,6 +50,12 @@ FACE = "FACE"
 #Results
 CANCELLED = "CANCELLED"
 FINISHED = "FINISHED"
+RUNNING_MODAL = "RUNNING_MODAL"
+PASS_THROUGH = "PASS_THROUGH"
+
+#Layout modes
+LAYOUT_ENGINE = "ENGINE"
+LAYOUT_SHELF = "SHELF"
 
 #Modes
 OBJECT = "OBJECT"
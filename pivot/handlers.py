@@ -18,7 +18,7 @@
 # Blender Event Handlers
 # -----------------------
 # Handles Blender lifecycle events including:
-# - File load/save events (load_pre, load_post)
+# - File load/save events (load_pre, load_post, save_pre)
 # - Depsgraph updates (on_depsgraph_update)
 
 import bpy
@@ -31,63 +31,94 @@ from pivot_lib import engine_state
 from pivot_lib import group_manager
 import elbo_sdk_rust as engine
 from pivot_lib import surface_manager
+from pivot_lib import shm_utils
+from pivot_lib import transform_utils
+from pivot_lib import engine_task
+from pivot_lib import change_tracker
+from pivot_lib import hierarchy_index
+from pivot_lib import command_queue
+from pivot_lib import layout
+from .constants import ENV_DEV_ENGINE_THREADS, ENV_ENGINE_THREADS
+from .operators.engine_modal import abort_running_jobs
 import time
 
-# Cache of each object's last-known scale to detect transform-only edits quickly.
-_previous_scales: dict[str, tuple[float, float, float]] = {}
-# Cache of each object's last-known rotation to detect rotation changes.
-_previous_rotations: dict[str, tuple[float, float, float, float]] = {}
 
 
 @persistent
 def on_depsgraph_update(scene, depsgraph):
     """Orchestrate all depsgraph update handlers in guaranteed order."""
     start_time = time.time()
+    group_mgr = group_manager.get_group_manager()
+    tracker = change_tracker.get_change_tracker()
+    tracker.consume_depsgraph(depsgraph, group_mgr)
+    hierarchy_index.get_hierarchy_index().consume_depsgraph(depsgraph)
+    changes = tracker.take_changes()
+    if changes.full_scan:
+        group_mgr.reindex_groups()
+        group_mgr.mark_colors_dirty()
+    elif changes.membership_groups:
+        group_mgr.reindex_groups(changes.membership_groups)
+
     if engine_state.is_performing_classification():
         engine_state.set_performing_classification(False)
+        refresh_transform_cache()
     else:
-        detect_collection_hierarchy_changes(scene, depsgraph)
+        detect_collection_hierarchy_changes(scene, depsgraph, changes)
         unsync_mesh_changes(scene, depsgraph)
-    enforce_colors(scene, depsgraph)
+    enforce_colors(scene, depsgraph, changes)
     end_time = time.time()
     # print(f"on_depsgraph_update took {1000 * (end_time - start_time):.4f} milliseconds")
 
 
-def detect_collection_hierarchy_changes(scene, depsgraph):
-    """Detect changes in collection hierarchy and mark affected groups as out-of-sync with the engine."""
+def detect_collection_hierarchy_changes(scene, depsgraph, changes):
+    """Detect changes in collection hierarchy and mark affected groups as out-of-sync with the engine.
+
+    Only groups whose collections were tagged are compared, unless the change
+    tracker requested a full scan.
+    """
     group_mgr = group_manager.get_group_manager()
-    
-    current_snapshot = group_mgr.get_group_membership_snapshot()
-    expected_snapshot = engine_state.get_group_membership_snapshot()
-    for group_name, expected_members in expected_snapshot.items():
-        current_members = current_snapshot.get(group_name, set())
-        if expected_members != current_members:
+
+    if changes.full_scan:
+        group_names = group_mgr.get_sync_state_keys()
+    else:
+        group_names = changes.membership_groups
+
+    for group_name in group_names:
+        if not engine_state.has_group_members(group_name):
+            continue
+        current_members = group_mgr.get_group_members(group_name) or set()
+        if not engine_state.group_members_match(group_name, current_members):
             group_mgr.set_group_unsynced(group_name)
 
 
-def enforce_colors(scene, depsgraph):
+def enforce_colors(scene, depsgraph, changes):
     """Enforce correct color tags for group collections based on sync state.
     
-    Also immediately handles orphaned groups by dropping them from engine,
-    sync state, and clearing their colors.
+    Also handles orphaned groups: they leave sync state and lose their colors
+    immediately, and their engine drop is queued so bulk deletes coalesce.
     """
     group_mgr = group_manager.get_group_manager()
-    orphaned_groups = group_mgr.update_orphaned_groups()
-    
-    # Immediately handle orphaned groups
+    if changes.structure_changed or changes.full_scan:
+        orphaned_groups = group_mgr.update_orphaned_groups()
+    elif changes.dirty_groups:
+        orphaned_groups = group_mgr.update_orphaned_groups(list(changes.dirty_groups))
+    else:
+        orphaned_groups = []
+
+    # While a modal standardize owns the engine, orphans are picked up again
+    # on a later update.
+    if orphaned_groups and engine_task.has_active_task():
+        change_tracker.get_change_tracker().request_structure_scan()
+        orphaned_groups = []
+
+    # Forget orphaned groups now; the engine drop is flushed later in one batch
     if orphaned_groups:
-        try:
-            # Drop from engine
-            dropped_count = engine.drop_groups_command(orphaned_groups)
-            if dropped_count >= 0:
-                # Clear their colors and remove from sync state
-                for coll_name in orphaned_groups:
-                    if coll_name in bpy.data.collections:
-                        bpy.data.collections[coll_name].color_tag = 'NONE'
-                group_mgr.drop_groups(orphaned_groups)
-                print(f"[Pivot] Dropped {dropped_count} orphaned groups from engine")
-        except Exception as e:
-            print(f"[Pivot] Error handling orphaned groups: {e}")
+        for coll_name in orphaned_groups:
+            if coll_name in bpy.data.collections:
+                bpy.data.collections[coll_name].color_tag = 'NONE'
+        group_mgr.drop_groups(orphaned_groups)
+        engine_state.drop_group_fingerprints(orphaned_groups)
+        command_queue.get_command_queue().queue_drops(orphaned_groups)
     
     # Update colors for remaining managed groups
     group_mgr.update_colors()
@@ -95,96 +126,98 @@ def enforce_colors(scene, depsgraph):
 
 def unsync_mesh_changes(scene, depsgraph):
     """Detect mesh and transform changes on selected objects and mark groups as unsynced."""
-    global _previous_scales, _previous_rotations
-    
     group_mgr = group_manager.get_group_manager()
 
     # Get all selected mesh objects first (quick operation)
     all_selected_mesh = [obj for obj in bpy.context.selected_objects if obj.type == 'MESH']
-    all_selected_mesh_set = set(all_selected_mesh)  # For O(1) lookup
     
     if not all_selected_mesh:
         return  # No selected objects, nothing to do
     
-    # Get managed collections info (fast, no full snapshot yet)
-    managed_group_names = group_mgr.get_sync_state_keys()  # Returns a set
-    
     selected_objects = []
     obj_to_groups = {}
     
-    # Iterate managed collections to find selected objects (avoids checking all 220 objects)
-    for group_name in managed_group_names:
-        # Get the collection
-        coll = bpy.data.collections.get(group_name)
-        if not coll:
-            continue
-        
-        # Check only objects in this collection against selected set (O(1) lookups)
-        for obj in coll.objects:
-            if obj in all_selected_mesh_set:
-                if obj not in selected_objects:
-                    selected_objects.append(obj)
-                if obj not in obj_to_groups:
-                    obj_to_groups[obj] = []
-                obj_to_groups[obj].append(group_name)
+    # O(1) per selected object via the GroupManager reverse index
+    for obj in all_selected_mesh:
+        group_names = group_mgr.get_object_group_names(obj)
+        if group_names:
+            selected_objects.append(obj)
+            obj_to_groups[obj] = group_names
     
     if not selected_objects:
         return  # No selected objects in managed collections
     
-    # Only build snapshots if we have selected objects to process
-    expected_snapshot = engine_state.get_group_membership_snapshot()
-    current_snapshot = group_mgr.get_group_membership_snapshot()
-    
+    sync_state = group_mgr.get_sync_state_dict()
+
     # Build reverse lookup for O(1) matching: update.id.original -> obj
     id_to_obj = {}
     for obj in selected_objects:
         id_to_obj[id(obj)] = obj
         id_to_obj[id(obj.data)] = obj
 
-    # Main processing loop
+    # Collect the selected objects touched by this update first so their world
+    # matrices can be compared against the transform cache in one batch.
+    updated_objects = []
+    updated_flags = []
+    seen = set()
     for update in depsgraph.updates:
         if not (update.is_updated_geometry or update.is_updated_transform):
             continue
 
         # O(1) lookup instead of O(m) loop
         obj = id_to_obj.get(id(update.id.original))
-        if obj is None:
+        if obj is None or id(obj) in seen:
             continue
+        seen.add(id(obj))
+        updated_objects.append(obj)
+        updated_flags.append((update.is_updated_geometry, update.is_updated_transform))
 
-        group_names = obj_to_groups.get(obj, [])
-        for group_name in group_names:
-            expected_members = expected_snapshot.get(group_name)
-            current_members = current_snapshot.get(group_name, set())
-            member_count = len(expected_members) if expected_members is not None else len(current_members)
+    if not updated_objects:
+        return
 
-            current_scale = tuple(obj.scale)
-            prev_scale = _previous_scales.get(obj.name)
-            scale_changed = prev_scale is not None and current_scale != prev_scale
+    basis_changed = transform_utils.get_transform_cache().basis_changed(
+        updated_objects, shm_utils.get_staging_arena())
 
-            current_rotation = tuple(obj.rotation_quaternion)
-            prev_rotation = _previous_rotations.get(obj.name)
-            rotation_changed = prev_rotation is not None and current_rotation != prev_rotation
+    for i, obj in enumerate(updated_objects):
+        is_updated_geometry, is_updated_transform = updated_flags[i]
+        group_names = obj_to_groups.get(obj, [])
+
+        # A geometry tag only matters if the evaluated mesh differs from what the
+        # engine holds; only pay for the hash while one of its groups is synced.
+        geometry_changed = is_updated_geometry
+        if geometry_changed and any(sync_state.get(name, False) for name in group_names):
+            geometry_changed = not shm_utils.mesh_matches_fingerprint(obj, depsgraph)
+        for group_name in group_names:
+            member_count = engine_state.get_group_member_count(group_name)
+            uploaded = member_count >= 0
+            if not uploaded:
+                member_count = len(bpy.data.collections[group_name].objects)
 
             should_mark_unsynced = (
-                expected_members is None
-                or update.is_updated_geometry
-                or scale_changed
-                or rotation_changed
-                or (update.is_updated_transform and member_count > 1)
+                not uploaded
+                or geometry_changed
+                or basis_changed[i]
+                or (is_updated_transform and member_count > 1)
             )
 
             if should_mark_unsynced:
                 group_mgr.set_group_unsynced(group_name)
 
-        # Update scale and rotation caches for next handler invocation
-        _previous_scales[obj.name] = current_scale
-        _previous_rotations[obj.name] = current_rotation
+
+def refresh_transform_cache():
+    """Record the transforms the last standardize applied as synced.
+
+    Called on the update that follows a standardize, once the depsgraph has
+    evaluated the new world matrices. Only the objects under the transformed
+    pivots are re-recorded; every other object keeps its cached value, so an
+    edit made to it earlier is still detected.
+    """
+    transform_utils.get_transform_cache().store_applied(shm_utils.get_staging_arena())
+
 
 def clear_previous_scales():
-    """Clear the scale and rotation caches used for detecting transform changes."""
-    global _previous_scales, _previous_rotations
-    _previous_scales.clear()
-    _previous_rotations.clear()
+    """Clear the transform cache used for detecting rotation and scale changes."""
+    transform_utils.get_transform_cache().clear()
 
 
 def on_group_name_changed(collection, group_mgr):
@@ -202,18 +235,57 @@ def on_group_name_changed(collection, group_mgr):
     if old_name and old_name != new_name:
         # Mark the collection as orphaned - enforce_colors will handle cleanup
         collection.color_tag = 'NONE'
+        # The rename's depsgraph update names a collection outside the sync
+        # state, so the old name is only dropped by a structure scan
+        change_tracker.get_change_tracker().request_structure_scan()
+
+
+@persistent
+def on_undo_redo(scene):
+    """Undo and redo reallocate IDs, so pointer-keyed caches must be rebuilt."""
+    # A running job holds objects, collections and pivots the undo just replaced
+    abort_running_jobs("undo")
+    change_tracker.get_change_tracker().request_full_scan()
+    # Fingerprints are pointer-keyed like the reverse index; synced groups
+    # re-fingerprint on their next upload
+    engine_state.clear_object_fingerprints()
+    transform_utils.get_transform_cache().clear()
+    surface_manager.get_surface_manager().invalidate_cache()
+    hierarchy_index.get_hierarchy_index().invalidate()
 
 
 # File Load Handlers
 # ------------------
 # Manage engine lifecycle and state synchronization around file load/save events.
 
+# Set by batch processing to reuse one engine process across file loads
+_keep_engine_alive = False
+
+
+def set_keep_engine_alive(value: bool) -> None:
+    """Keep the engine running across file loads (groups are dropped instead)."""
+    global _keep_engine_alive
+    _keep_engine_alive = value
+
 @persistent
 def on_load_pre(scene):
     """Executed before a new file is loaded.
     
     Shuts down the engine and syncs any pending classification state before file load.
     """
+    # Blender drops modal handlers on load, so the running job never sees another event
+    abort_running_jobs("file load")
+    # Let an in-flight modal standardize return before talking to the engine
+    engine_task.wait_for_active_task()
+
+    # Queued drops still matter to an engine that outlives this file
+    queue = command_queue.get_command_queue()
+    if _keep_engine_alive:
+        queue.flush()
+    else:
+        queue.clear()
+    queue.unregister_timer()
+
     try:
         # Sync any pending group classifications to the engine before shutting down
         surface_mgr = surface_manager.get_surface_manager()
@@ -223,10 +295,54 @@ def on_load_pre(scene):
     except Exception as e:
         print(f"[Pivot] Failed to sync classifications before load: {e}")
     
-    # Stop the pivot engine
-    engine.stop_engine()
+    if _keep_engine_alive:
+        # Forget this file's groups but keep the engine process
+        managed_groups = list(group_manager.get_group_manager().get_managed_group_names_set())
+        if managed_groups:
+            try:
+                engine_state.timed_command("drop_groups_command", engine.drop_groups_command, managed_groups)
+                engine_state.forget_group_uploads(managed_groups)
+            except Exception as e:
+                print(f"[Pivot] Failed to drop groups before load: {e}")
+    else:
+        # Stop the pivot engine
+        engine.stop_engine()
+        engine_state.clear_group_uploads()
+
+    # Staging buffers are sized for the current file's selections
+    shm_utils.release_staging_arena()
     
 
+def _get_dev_engine_threads() -> int:
+    """Return the developer thread count override, or 0 when unset or invalid."""
+    try:
+        return max(0, int(os.environ.get(ENV_DEV_ENGINE_THREADS, "0")))
+    except ValueError:
+        return 0
+
+
+def start_engine() -> None:
+    """Start the engine, forwarding the developer thread count override if set.
+
+    The engine process inherits Blender's environment, so the override is
+    exported only around the start call and the previous value is restored.
+    """
+    threads = _get_dev_engine_threads()
+    if threads <= 0:
+        engine.start_engine()
+        return
+
+    saved = os.environ.get(ENV_ENGINE_THREADS)
+    os.environ[ENV_ENGINE_THREADS] = str(threads)
+    try:
+        engine.start_engine()
+    finally:
+        if saved is None:
+            os.environ.pop(ENV_ENGINE_THREADS, None)
+        else:
+            os.environ[ENV_ENGINE_THREADS] = saved
+
+
 @persistent
 def on_load_post(scene):
     """Executed after a new file has finished loading.
@@ -238,9 +354,35 @@ def on_load_post(scene):
     
     # Initialize engine state for the new scene
     engine_state.update_group_membership_snapshot({}, replace=True)
+    engine_state.clear_object_fingerprints()
+    change_tracker.get_change_tracker().reset()
+    surface_manager.get_surface_manager().invalidate_cache()
+    hierarchy_index.get_hierarchy_index().invalidate()
+    layout.get_shelf_layout().reset()
     clear_previous_scales()
 
-    engine.start_engine()
+    if not _keep_engine_alive:
+        start_engine()
+
+    # Re-adopt the groups this file was saved with. Engine state is not
+    # persisted, so they come back unsynced and need a full geometry upload
+    scene = bpy.context.scene
+    if scene is not None:
+        restored = group_manager.get_group_manager().restore_state(scene)
+        if restored:
+            print(f"[Pivot] Restored {len(restored)} managed groups from file")
+
+
+@persistent
+def on_save_pre(*args):
+    """Executed before the file is written; stores the managed group list on the scene."""
+    scene = bpy.context.scene
+    if scene is None:
+        return
+    try:
+        group_manager.get_group_manager().save_state(scene)
+    except Exception as e:
+        print(f"[Pivot] Failed to store group state before save: {e}")
     
     
     
\ No newline at end of file
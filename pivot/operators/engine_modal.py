@@ -0,0 +1,195 @@
+# Copyright (C) 2025 [Nicholas Wierzbowski/Elbo Studio]
+
+# This file is part of the Pivot Bridge for Blender.
+
+# The Pivot Bridge for Blender is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; either version 3
+# of the License, or (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, see <https://www.gnu.org/licenses>.
+
+"""Modal driver for engine jobs.
+
+Operators mix in EngineJobModal to run standardize jobs without blocking the
+UI: invoke() submits the first job, a window timer polls it, and results are
+applied on the main thread as soon as the engine returns. Esc cancels; the
+engine finishes its current command in the background and the result is
+discarded. execute() stays blocking for scripts and the redo panel.
+
+A job stopped by Esc or an error after the scene was already edited (an
+earlier job applied, or a starter that reorganizes the scene ran) still
+returns FINISHED with a warning, so the edits get an undo step.
+
+Undo and redo reallocate the IDs a job holds, so handlers call
+abort_running_jobs(); the job is cancelled at once and the modal ends on its
+next event without applying anything.
+"""
+
+import bpy
+
+from ..constants import CANCELLED, FINISHED, RUNNING_MODAL, PASS_THROUGH
+from pivot_lib import instrumentation
+
+# Seconds between polls of the running engine job
+POLL_INTERVAL = 0.1
+
+# The operator whose jobs are in flight, so handlers can abort it
+_running = None
+
+
+def abort_running_jobs(reason):
+    """Cancel the in-flight modal job; the operator ends on its next event."""
+    global _running
+    if _running is not None:
+        running = _running
+        # Cleared first: the modal may never see another event (file load)
+        _running = None
+        running._abort(reason)
+
+
+class EngineJobModal:
+    """Mixin running a queue of engine jobs from a modal timer.
+
+    Subclasses call _start_jobs() from invoke() with a list of zero-argument
+    callables, each returning a job (poll/cancel/elapsed/finish), and
+    implement _apply_job(context, job) to consume each finished job. Jobs also
+    report progress() as (completed chunks, total chunks). Subclasses whose
+    starters edit the scene before the engine runs set _starters_edit_scene.
+    """
+
+    _timer = None
+    _job = None
+    # instrumentation.DetachedCall, current only while a slice of this operator runs
+    _call = None
+    _pending = None
+    _status_label = "Pivot"
+    _call_name = "engine_job"
+    _job_index = 0
+    _job_total = 0
+    _starters_edit_scene = False
+    _abort_reason = None
+
+    def _start_jobs(self, context, job_starters):
+        self._pending = list(job_starters)
+        self._job_total = len(self._pending)
+        self._job_index = 0
+        if not self._pending:
+            return {FINISHED}
+
+        self._call = instrumentation.detached_call(self._call_name)
+        self._call.resume()
+        try:
+            self._job = self._pending.pop(0)()
+        except Exception as e:
+            self._call.finish()
+            self._call = None
+            return self._stopped({"ERROR"}, str(e))
+        finally:
+            if self._call is not None:
+                self._call.suspend()
+
+        wm = context.window_manager
+        self._timer = wm.event_timer_add(POLL_INTERVAL, window=context.window)
+        wm.modal_handler_add(self)
+        global _running
+        _running = self
+        self._update_status(context)
+        return {RUNNING_MODAL}
+
+    def _apply_job(self, context, job):
+        raise NotImplementedError
+
+    def _on_jobs_finished(self, context):
+        """Hook run after the last job has been applied."""
+        pass
+
+    def _scene_edited(self):
+        return self._job_index > 0 or self._starters_edit_scene
+
+    def _stopped(self, level, message):
+        """Report a cancel or failure; FINISHED if edits were already made, so they get an undo step."""
+        if self._scene_edited():
+            self.report({"WARNING"}, f"{message}; changes made so far were kept (undo to revert)")
+            return {FINISHED}
+        self.report(level, message)
+        return {CANCELLED}
+
+    def _abort(self, reason):
+        self._abort_reason = reason
+        self._pending = []
+        if self._job is not None:
+            self._job.cancel()
+
+    def modal(self, context, event):
+        if self._abort_reason is not None:
+            self._end(context)
+            # Whatever was applied was reverted with the undo step that aborted the job
+            self.report({"WARNING"}, f"{self._status_label} cancelled: {self._abort_reason}")
+            return {CANCELLED}
+
+        if event.type == 'ESC':
+            self._job.cancel()
+            self._end(context)
+            return self._stopped({"WARNING"}, f"{self._status_label} cancelled")
+
+        if event.type != 'TIMER':
+            return {PASS_THROUGH}
+
+        self._call.resume()
+        try:
+            return self._poll_jobs(context)
+        finally:
+            if self._call is not None:
+                self._call.suspend()
+
+    def _poll_jobs(self, context):
+        try:
+            if not self._job.poll():
+                self._update_status(context)
+                return {PASS_THROUGH}
+
+            self._apply_job(context, self._job)
+            self._job_index += 1
+            if self._pending:
+                self._job = self._pending.pop(0)()
+                self._update_status(context)
+                return {PASS_THROUGH}
+        except Exception as e:
+            if self._job is not None:
+                self._job.cancel()
+            self._end(context)
+            return self._stopped({"ERROR"}, f"{self._status_label} failed: {e}")
+
+        self._end(context)
+        self._on_jobs_finished(context)
+        return {FINISHED}
+
+    def _update_status(self, context):
+        progress = f" ({self._job_index + 1}/{self._job_total})" if self._job_total > 1 else ""
+        chunks_done, chunk_total = self._job.progress()
+        chunks = f", chunk {chunks_done + 1}/{chunk_total}" if chunk_total > 1 else ""
+        text = f"{self._status_label}{progress}: engine working {self._job.elapsed():.1f}s{chunks} - Esc to cancel"
+        if context.workspace is not None:
+            context.workspace.status_text_set(text)
+
+    def _end(self, context):
+        if self._timer is not None:
+            context.window_manager.event_timer_remove(self._timer)
+            self._timer = None
+        if context.workspace is not None:
+            context.workspace.status_text_set(None)
+        self._job = None
+        self._pending = None
+        global _running
+        if _running is self:
+            _running = None
+        if self._call is not None:
+            self._call.finish()
+            self._call = None
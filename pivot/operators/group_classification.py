@@ -17,15 +17,18 @@
 
 import bpy
 import time
+from functools import partial
 
 from ..constants import PRE, FINISHED
 from pivot_lib import standardize
 from pivot_lib import group_manager
 from pivot_lib import engine_state
+from pivot_lib import engine_task
 from ..classification_utils import get_qualifying_objects_for_selected, selected_has_qualifying_objects
+from .engine_modal import EngineJobModal
 
 
-class Pivot_OT_Standardize_Selected_Groups(bpy.types.Operator):
+class Pivot_OT_Standardize_Selected_Groups(EngineJobModal, bpy.types.Operator):
     """
     Pro Edition: Standardize Selected Groups
     
@@ -38,14 +41,48 @@ class Pivot_OT_Standardize_Selected_Groups(bpy.types.Operator):
     bl_label = "Standardize & Classify Selected Assets"
     bl_description = "Analyzes the selection to identify asset hierarchies (parenting/collection-based) in the Source Collection. Runs the full standardization and classification process on each group, then creates a new, perfectly organized Outliner structure. This is the main 'processing' step for your scene"
     bl_options = {"REGISTER", "UNDO"}
+    _status_label = "Standardizing groups"
+    _call_name = "standardize_groups"
+    # Aggregation creates group collections and pivots before the engine runs
+    _starters_edit_scene = True
     
 
     @classmethod
     def poll(cls, context):
+        if engine_task.has_active_task():
+            return False
         sel = getattr(context, "selected_objects", None) or []
         objects_collection = group_manager.get_group_manager().get_objects_collection()
         return selected_has_qualifying_objects(sel, objects_collection)
 
+    def invoke(self, context, event):
+        # Exit edit mode if active to ensure mesh data is accessible
+        if bpy.context.mode == 'EDIT_MESH':
+            bpy.ops.object.mode_set(mode='OBJECT')
+
+        self._start_time = time.perf_counter()
+
+        objects_collection = group_manager.get_group_manager().get_objects_collection()
+        objects = get_qualifying_objects_for_selected(context.selected_objects, objects_collection)
+        origin_method = context.scene.pivot.origin_method
+        surface_type = context.scene.pivot.surface_type
+        submission_mode = context.scene.pivot.submission_mode
+
+        return self._start_jobs(context, [
+            partial(standardize.begin_standardize_groups, objects, origin_method, surface_type, submission_mode)
+        ])
+
+    def _apply_job(self, context, job):
+        job.finish()
+        skipped = job.skipped_group_names()
+        if skipped:
+            self.report({"WARNING"}, f"Skipped {len(skipped)} groups edited during standardize; run it again to include them")
+
+    def _on_jobs_finished(self, context):
+        elapsed = time.perf_counter() - self._start_time
+        print(f"Standardize Selected Groups completed in {(elapsed) * 1000:.2f}ms")
+        engine_state.set_performing_classification(True)
+
     def execute(self, context):
         # Exit edit mode if active to ensure mesh data is accessible
         if bpy.context.mode == 'EDIT_MESH':
@@ -57,11 +94,13 @@ class Pivot_OT_Standardize_Selected_Groups(bpy.types.Operator):
         objects = get_qualifying_objects_for_selected(context.selected_objects, objects_collection)
         origin_method = context.scene.pivot.origin_method
         surface_type = context.scene.pivot.surface_type
+        submission_mode = context.scene.pivot.submission_mode
         
         standardize.standardize_groups(
             objects, 
             origin_method=origin_method, 
-            surface_context=surface_type
+            surface_context=surface_type,
+            submission_mode=submission_mode
         )
         
         endTime = time.perf_counter()
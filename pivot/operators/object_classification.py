@@ -17,17 +17,20 @@
 
 import bpy
 import time
+from functools import partial
 
 from ..constants import PRE, FINISHED, LICENSE_PRO
 from pivot_lib import standardize
+from pivot_lib import engine_task
 from ..classification_utils import get_qualifying_objects_for_selected, selected_has_qualifying_objects
 from pivot_lib.engine_state import get_engine_license_status
+from .engine_modal import EngineJobModal
 
 # Operator descriptions
 DESC_SET_ORIGIN_SELECTED = "Applies the configured 'Origin Method' to each selected object, respecting the chosen 'Surface Context'. Use this to fix only the origins without affecting rotation"
 DESC_ALIGN_FACING_SELECTED = "Applies the 'Align Facing' rotation to each selected object, respecting the chosen 'Surface Context' to determine the correct 'forward' direction"
 
-class Pivot_OT_Set_Origin_Selected_Objects(bpy.types.Operator):
+class Pivot_OT_Set_Origin_Selected_Objects(EngineJobModal, bpy.types.Operator):
     """
     Sets origin for one or more selected objects.
     """
@@ -36,15 +39,50 @@ class Pivot_OT_Set_Origin_Selected_Objects(bpy.types.Operator):
     bl_description = DESC_SET_ORIGIN_SELECTED
     bl_options = {"REGISTER", "UNDO"}
     bl_icon = 'OBJECT_DATA'
+    _status_label = "Standardizing origins"
+    _call_name = "standardize_object_origins"
 
     @classmethod
     def poll(cls, context):
+        if engine_task.has_active_task():
+            return False
         sel = getattr(context, "selected_objects", None) or []
         scene_collection = getattr(context.scene, "collection", None)
         if not scene_collection:
             return False
         return selected_has_qualifying_objects(sel, scene_collection)
 
+    def invoke(self, context, event):
+        scene_collection = getattr(context.scene, "collection", None)
+        if not scene_collection:
+            return {FINISHED}
+        objects = get_qualifying_objects_for_selected(context.selected_objects, scene_collection)
+        # Exit edit mode if active to ensure mesh data is accessible
+        if bpy.context.mode == 'EDIT_MESH':
+            bpy.ops.object.mode_set(mode='OBJECT')
+
+        self._start_time = time.perf_counter()
+        self._origin_method = context.scene.pivot.origin_method
+        surface_type = context.scene.pivot.surface_type
+        submission_mode = context.scene.pivot.submission_mode
+
+        # Standard edition classifies one object per engine call
+        if get_engine_license_status() != LICENSE_PRO and len(objects) > 1:
+            batches = [[obj] for obj in objects]
+        else:
+            batches = [objects]
+        return self._start_jobs(context, [
+            partial(standardize.begin_object_standardize, batch, surface_type, submission_mode) for batch in batches
+        ])
+
+    def _apply_job(self, context, job):
+        mesh_objects, results = job.finish()
+        standardize.apply_object_origins(mesh_objects, results, self._origin_method)
+
+    def _on_jobs_finished(self, context):
+        elapsed = time.perf_counter() - self._start_time
+        print(f"Set Origin Selected Objects completed in {(elapsed) * 1000:.2f}ms")
+
     def execute(self, context):
         scene_collection = getattr(context.scene, "collection", None)
         if not scene_collection:
@@ -59,11 +97,12 @@ class Pivot_OT_Set_Origin_Selected_Objects(bpy.types.Operator):
         license_type = get_engine_license_status()
         origin_method = context.scene.pivot.origin_method
         surface_type = context.scene.pivot.surface_type
+        submission_mode = context.scene.pivot.submission_mode
         if license_type != LICENSE_PRO and len(objects) > 1:
             for obj in objects:
-                standardize.standardize_object_origins([obj], origin_method=origin_method, surface_context=surface_type)
+                standardize.standardize_object_origins([obj], origin_method=origin_method, surface_context=surface_type, submission_mode=submission_mode)
         else:
-            standardize.standardize_object_origins(objects, origin_method=origin_method, surface_context=surface_type)
+            standardize.standardize_object_origins(objects, origin_method=origin_method, surface_context=surface_type, submission_mode=submission_mode)
         
         endTime = time.perf_counter()
         elapsed = endTime - startTime
@@ -71,7 +110,7 @@ class Pivot_OT_Set_Origin_Selected_Objects(bpy.types.Operator):
         return {FINISHED}
 
 
-class Pivot_OT_Align_Facing_Selected_Objects(bpy.types.Operator):
+class Pivot_OT_Align_Facing_Selected_Objects(EngineJobModal, bpy.types.Operator):
     """
     Aligns facing for one or more selected objects.
     """
@@ -80,15 +119,48 @@ class Pivot_OT_Align_Facing_Selected_Objects(bpy.types.Operator):
     bl_description = DESC_ALIGN_FACING_SELECTED
     bl_options = {"REGISTER", "UNDO"}
     bl_icon = 'OBJECT_DATA'
+    _status_label = "Standardizing rotations"
+    _call_name = "standardize_object_rotations"
 
     @classmethod
     def poll(cls, context):
+        if engine_task.has_active_task():
+            return False
         sel = getattr(context, "selected_objects", None) or []
         scene_collection = getattr(context.scene, "collection", None)
         if not scene_collection:
             return False
         return selected_has_qualifying_objects(sel, scene_collection)
 
+    def invoke(self, context, event):
+        scene_collection = getattr(context.scene, "collection", None)
+        if not scene_collection:
+            return {FINISHED}
+        objects = get_qualifying_objects_for_selected(context.selected_objects, scene_collection)
+        # Exit edit mode if active to ensure mesh data is accessible
+        if bpy.context.mode == 'EDIT_MESH':
+            bpy.ops.object.mode_set(mode='OBJECT')
+
+        self._start_time = time.perf_counter()
+
+        # Standard edition classifies one object per engine call
+        if get_engine_license_status() != LICENSE_PRO and len(objects) > 1:
+            batches = [[obj] for obj in objects]
+        else:
+            batches = [objects]
+        submission_mode = context.scene.pivot.submission_mode
+        return self._start_jobs(context, [
+            partial(standardize.begin_object_standardize, batch, "AUTO", submission_mode) for batch in batches
+        ])
+
+    def _apply_job(self, context, job):
+        mesh_objects, results = job.finish()
+        standardize.apply_object_rotations(mesh_objects, results)
+
+    def _on_jobs_finished(self, context):
+        elapsed = time.perf_counter() - self._start_time
+        print(f"Align Facing Selected Objects completed in {(elapsed) * 1000:.2f}ms")
+
     def execute(self, context):
         scene_collection = getattr(context.scene, "collection", None)
         if not scene_collection:
@@ -101,11 +173,12 @@ class Pivot_OT_Align_Facing_Selected_Objects(bpy.types.Operator):
         startTime = time.perf_counter()
         
         license_type = get_engine_license_status()
+        submission_mode = context.scene.pivot.submission_mode
         if license_type != LICENSE_PRO and len(objects) > 1:
             for obj in objects:
-                standardize.standardize_object_rotations([obj])
+                standardize.standardize_object_rotations([obj], submission_mode)
         else:
-            standardize.standardize_object_rotations(objects)
+            standardize.standardize_object_rotations(objects, submission_mode)
         
         endTime = time.perf_counter()
         elapsed = endTime - startTime
@@ -22,10 +22,15 @@ import time
 from mathutils import Vector
 
 from pivot_lib import engine_state
+from pivot_lib import instrumentation
+from pivot_lib import engine_task
+from pivot_lib import layout
+from pivot_lib import command_queue
 # import elbo_sdk_rust as engine
 from ..constants import (
     CANCELLED,
     FINISHED,
+    LAYOUT_SHELF,
     LICENSE_PRO,
     PRE,
 )
@@ -45,22 +50,32 @@ class Pivot_OT_Organize_Classified_Objects(bpy.types.Operator):
     @classmethod
     def poll(cls, context):
         # Return true if we have existing groups (checked via collection metadata)
+        if engine_task.has_active_task():
+            return False
         group_mgr = group_manager.get_group_manager()
         return group_mgr.has_existing_groups()
 
     def execute(self, context):
+        with instrumentation.call("organize_objects"):
+            return self._organize(context)
+
+    def _organize(self, context):
         start_total = time.perf_counter()
         try:
             from pivot_lib import standardize
             
-            # First, standardize all managed groups
+            # First, re-standardize groups the engine is out of date on. Synced
+            # groups already transformed with BASE (what organize uses) are skipped.
             group_mgr = group_manager.get_group_manager()
-            managed_groups = list(group_mgr.get_managed_group_names_set())
+            stale_groups = [
+                name for name, synced in group_mgr.get_sync_state().items()
+                if not synced or not group_mgr.was_group_last_transformed_using_base(name)
+            ]
             
-            if managed_groups:
-                # Collect all objects from managed groups to standardize them
+            if stale_groups:
+                # Collect all objects from stale groups to standardize them
                 objects_to_standardize = []
-                for group_name in managed_groups:
+                for group_name in stale_groups:
                     if group_name in bpy.data.collections:
                         group_coll = bpy.data.collections[group_name]
                         objects_to_standardize.extend(list(group_coll.objects))
@@ -70,7 +85,8 @@ class Pivot_OT_Organize_Classified_Objects(bpy.types.Operator):
                         standardize.standardize_groups(
                             objects_to_standardize, 
                             "BASE", 
-                            "AUTO"
+                            "AUTO",
+                            context.scene.pivot.submission_mode
                         )
                     except Exception as e:
                         self.report({"WARNING"}, f"Failed to standardize groups: {e}")
@@ -83,10 +99,17 @@ class Pivot_OT_Organize_Classified_Objects(bpy.types.Operator):
                 if not sync_ok:
                     self.report({"WARNING"}, "Failed to sync classifications to engine; results may be outdated")
 
+            if context.scene.pivot.layout_mode == LAYOUT_SHELF:
+                return self._arrange_packed(group_mgr, classifications, start_total)
+
             # Call the engine to organize objects
             start_engine = time.perf_counter()
             
-            response = json.loads(engine.organize_objects_command())
+            with instrumentation.stage(instrumentation.STAGE_ENGINE):
+                command_queue.get_command_queue().flush()
+                response_json = engine_state.timed_command("organize_objects_command", engine.organize_objects_command)
+            with instrumentation.stage(instrumentation.STAGE_JSON):
+                response = json.loads(response_json)
             end_engine = time.perf_counter()
             
             start_post = time.perf_counter()
@@ -137,6 +160,33 @@ class Pivot_OT_Organize_Classified_Objects(bpy.types.Operator):
         return {FINISHED}
 
 
+    def _arrange_packed(self, group_mgr, classifications, start_total):
+        """Place groups with the incremental shelf layout instead of the engine's rows."""
+        start_layout = time.perf_counter()
+        with instrumentation.stage(instrumentation.STAGE_ORGANIZE):
+            names, footprints, roots = layout.compute_group_footprints(sorted(group_mgr.get_managed_group_names_set()))
+            surface_keys = [classifications.get(name, -1) for name in names]
+            positions = layout.get_shelf_layout().arrange(names, footprints, surface_keys)
+
+        # Only write locations that actually change
+        moved_count = 0
+        with instrumentation.stage(instrumentation.STAGE_APPLY):
+            for i, group_roots in enumerate(roots):
+                target_pos = Vector(positions[i])
+                moved = False
+                for obj in group_roots:
+                    if (obj.location - target_pos).length_squared > 1e-10:
+                        obj.location = target_pos
+                        moved = True
+                moved_count += moved
+
+        self.report({"INFO"}, f"Organized {len(names)} object groups ({moved_count} moved)")
+        engine_state.set_performing_classification(True)
+        end_total = time.perf_counter()
+        print(f"Organize objects (packed) - Layout: {(end_total - start_layout) * 1000:.2f}ms, Total: {(end_total - start_total) * 1000:.2f}ms")
+        return {FINISHED}
+
+
 class Pivot_OT_Reset_Classifications(bpy.types.Operator):
     bl_idname = "object." + PRE.lower() + "reset_classifications"
     bl_label = "Reset Classifications"
@@ -171,6 +221,7 @@ class Pivot_OT_Reset_Classifications(bpy.types.Operator):
                     print(f"[Pivot] Failed to delete collection '{coll.name}': {e}")
                     self.report({"WARNING"}, f"Failed to delete collection: {coll.name}")
             
+            layout.get_shelf_layout().reset()
             if deleted_count > 0:
                 self.report({"INFO"}, f"Reset classifications: deleted {deleted_count} collection(s)")
                 engine_state.set_performing_classification(True)
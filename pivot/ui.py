@@ -16,6 +16,7 @@
 # along with this program; if not, see <https://www.gnu.org/licenses>.
 
 from re import S
+import os
 import bpy
 from .operators.operators import (
     Pivot_OT_Organize_Classified_Objects,
@@ -30,8 +31,10 @@ from .operators.object_classification import (
 )
 
 from .constants import PRE, CATEGORY, LICENSE_PRO
-from .classes import LABEL_OBJECTS_COLLECTION, LABEL_ORIGIN_METHOD, LABEL_SURFACE_TYPE
+from .classes import LABEL_OBJECTS_COLLECTION, LABEL_ORIGIN_METHOD, LABEL_SURFACE_TYPE, LABEL_SUBMISSION_MODE, LABEL_LAYOUT_MODE
 from pivot_lib.engine_state import get_engine_license_status, set_engine_license_status
+from pivot_lib import engine_state
+from pivot_lib import instrumentation
 import elbo_sdk_rust as engine
 
 
@@ -83,6 +86,14 @@ class Pivot_PT_Configuration_Panel(bpy.types.Panel):
         row.label(text=LABEL_ORIGIN_METHOD)
         row = layout.row()
         row.prop(bpy.context.scene.pivot, "origin_method", expand=True)
+        row = layout.row()
+        row.label(text=LABEL_SUBMISSION_MODE)
+        row = layout.row()
+        row.prop(bpy.context.scene.pivot, "submission_mode", expand=True)
+        row = layout.row()
+        row.label(text=LABEL_LAYOUT_MODE)
+        row = layout.row()
+        row.prop(bpy.context.scene.pivot, "layout_mode", expand=True)
 
 
 class Pivot_PT_Pro_Panel(bpy.types.Panel):
@@ -160,3 +171,102 @@ class Pivot_PT_Standard_Panel(bpy.types.Panel):
         row = layout.row()
         row.operator(Pivot_OT_Align_Facing_Selected_Objects.bl_idname, icon=Pivot_OT_Align_Facing_Selected_Objects.bl_icon)
 
+
+class Pivot_PT_Performance_Panel(bpy.types.Panel):
+    bl_label = "Performance"
+    bl_idname = PRE + "_PT_performance_panel"
+    bl_space_type = "VIEW_3D"
+    bl_region_type = "UI"
+    bl_category = CATEGORY  # Tab name in the N-Panel
+    bl_options = {'DEFAULT_CLOSED'}
+
+    def draw(self, context):
+        layout = self.layout
+
+        last_call = instrumentation.get_last_call()
+        if last_call is None:
+            layout.label(text="No operations recorded yet")
+            return
+
+        layout.label(text=f"{last_call['name']}: {last_call['elapsed'] * 1000:.1f} ms")
+
+        stages = last_call["stages"]
+        if stages:
+            box = layout.box()
+            for stage_name, seconds in stages.items():
+                row = box.row()
+                row.label(text=stage_name)
+                row.label(text=f"{seconds * 1000:.1f} ms")
+
+        counters = last_call["counters"]
+        if counters:
+            box = layout.box()
+            for counter_name, value in counters.items():
+                row = box.row()
+                row.label(text=counter_name)
+                row.label(text=f"{value:,}")
+
+
+_ENGINE_DIR = os.path.join(os.path.dirname(__file__), "bin")
+
+
+def _format_bytes(value):
+    if value is None:
+        return "n/a"
+    for unit in ("B", "KiB", "MiB", "GiB"):
+        if value < 1024 or unit == "GiB":
+            return f"{value:,.0f} {unit}" if unit == "B" else f"{value:,.1f} {unit}"
+        value /= 1024
+
+
+def _format_seconds(seconds):
+    if seconds == float("inf"):
+        return "more"
+    return f"{seconds * 1000:.0f} ms" if seconds < 1.0 else f"{seconds:.0f} s"
+
+
+class Pivot_PT_Engine_Panel(bpy.types.Panel):
+    bl_label = "Engine"
+    bl_idname = PRE + "_PT_engine_panel"
+    bl_space_type = "VIEW_3D"
+    bl_region_type = "UI"
+    bl_category = CATEGORY  # Tab name in the N-Panel
+    bl_options = {'DEFAULT_CLOSED'}
+
+    def draw(self, context):
+        layout = self.layout
+        stats = engine_state.get_engine_stats(_ENGINE_DIR)
+
+        box = layout.box()
+        rows = (
+            ("Process", str(stats["pid"]) if stats["pid"] else "not found"),
+            ("Resident memory", _format_bytes(stats["resident_bytes"])),
+            ("Cached groups", f"{stats['cached_groups']:,}"),
+            ("Uploaded geometry", _format_bytes(stats["cached_bytes"])),
+            ("Commands in flight", str(stats["commands_in_flight"])),
+            ("SHM segments (engine)", "n/a" if stats["shm_segments"] is None else str(stats["shm_segments"])),
+            ("SHM segments (Blender)", "n/a" if stats["bridge_shm_segments"] is None else str(stats["bridge_shm_segments"])),
+        )
+        for label, value in rows:
+            row = box.row()
+            row.label(text=label)
+            row.label(text=value)
+
+        latency = stats["latency"]
+        if not latency:
+            layout.label(text="No engine commands recorded yet")
+            return
+
+        bounds = engine_state.get_latency_bucket_bounds()
+        for command, entry in latency.items():
+            box = layout.box()
+            row = box.row()
+            row.label(text=command)
+            row.label(text=f"{entry['count']}x, avg {entry['total'] / entry['count'] * 1000:.1f} ms, max {entry['max'] * 1000:.1f} ms")
+            # Only the populated buckets; each row is "<= bound: count"
+            for bound, count in zip(bounds, entry["buckets"]):
+                if count:
+                    row = box.row()
+                    row.label(text=f"  <= {_format_seconds(bound)}")
+                    row.label(text=f"{count}")
+